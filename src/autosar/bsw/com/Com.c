@@ -7,6 +7,7 @@
  */
 
 #include "Com.h"
+#include "Os.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -27,10 +28,30 @@ typedef struct {
     uint8 bitLength;         /* Signal length in bits */
 } Com_SignalMappingType;
 
+/* Signal update handed from the SWC cores to Com_MainFunctionTx() */
+typedef struct {
+    Com_SignalIdType signalId;
+    uint32 value;
+} Com_TxSignalUpdateType;
+
+/* Snapshot of all received bus signals, published to the SWC cores */
+typedef struct {
+    uint32 values[COM_SIGNAL_BUS_COUNT];
+} Com_RxSignalSetType;
+
+/* Cross-core traffic goes through IOC; the buffers below are owned by COM */
+#define COM_TX_QUEUE_LENGTH 32u
+
+OS_IOC_DEFINE_QUEUED(ComTx, OS_IOC_COM_TX, Com_TxSignalUpdateType)
+OS_IOC_DEFINE_UNQUEUED(ComRx, OS_IOC_COM_RX, Com_RxSignalSetType)
+
 /* PDU transmission buffers */
 static Com_PduBufferType tx_buffers[COM_IPDU_COUNT];
 static Com_PduBufferType rx_buffers[COM_IPDU_COUNT];
 
+/* Next periodic transmission of each PDU (OS time in ns), 0 = not started */
+static uint64 next_tx_ns[COM_IPDU_COUNT];
+
 /* Signal values cache */
 static uint32 tx_signals[COM_SIGNAL_BUS_COUNT];
 static uint32 rx_signals[COM_SIGNAL_BUS_COUNT];
@@ -119,6 +140,25 @@ static uint32 UnpackSignalFromPdu(Com_SignalIdType signalId) {
 }
 
 Std_ReturnType Com_Init(void) {
+    const Os_IocConfigType tx_channel = {
+        .semantics = OS_IOC_QUEUED,
+        .data_size = sizeof(Com_TxSignalUpdateType),
+        .queue_length = COM_TX_QUEUE_LENGTH,
+        .multi_sender = TRUE,
+    };
+    const Os_IocConfigType rx_channel = {
+        .semantics = OS_IOC_UNQUEUED,
+        .data_size = sizeof(Com_RxSignalSetType),
+        .queue_length = 0,
+        .multi_sender = FALSE,
+    };
+    
+    if (Os_ConfigureIoc(OS_IOC_COM_TX, &tx_channel) != OS_STATUS_OK ||
+        Os_ConfigureIoc(OS_IOC_COM_RX, &rx_channel) != OS_STATUS_OK) {
+        printf("[COM] ERROR: IOC channels not available\n");
+        return E_NOT_OK;
+    }
+    
     /* Initialize PDU buffers */
     memset(tx_buffers, 0, sizeof(tx_buffers));
     memset(rx_buffers, 0, sizeof(rx_buffers));
@@ -126,6 +166,7 @@ Std_ReturnType Com_Init(void) {
     /* Initialize signal caches */
     memset(tx_signals, 0, sizeof(tx_signals));
     memset(rx_signals, 0, sizeof(rx_signals));
+    memset(next_tx_ns, 0, sizeof(next_tx_ns));
     
     /* Configure PDU properties */
     for (uint32 i = 0; i < sizeof(pdu_config) / sizeof(pdu_config[0]); i++) {
@@ -148,14 +189,16 @@ Std_ReturnType Com_SendSignal(Com_SignalIdType signalId, const void* signalData)
         return E_NOT_OK;
     }
     
-    /* Cache the signal value */
-    uint32 value = *(const uint32*)signalData;
-    tx_signals[signalId] = value;
-    
-    /* Pack signal into PDU */
-    PackSignalIntoPdu(signalId, value);
+    /* Hand the value to Com_MainFunctionTx(), which packs it into its PDU */
+    Com_TxSignalUpdateType update = { signalId, *(const uint32*)signalData };
+    Std_ReturnType result = IocSend_ComTx(&update);
+    if (result != IOC_E_OK) {
+        printf("[COM] ERROR: Signal %u dropped (%s)\n", signalId,
+               (result == IOC_E_LIMIT) ? "TX queue full" : "COM not initialized");
+        return E_NOT_OK;
+    }
     
-    printf("[COM] Signal %u prepared for transmission (value: %u)\n", signalId, value);
+    printf("[COM] Signal %u prepared for transmission (value: %u)\n", signalId, update.value);
     
     return E_OK;
 }
@@ -165,20 +208,63 @@ Std_ReturnType Com_ReceiveSignal(Com_SignalIdType signalId, void* signalData) {
         return E_NOT_OK;
     }
     
-    /* Return cached signal value */
-    *(uint32*)signalData = rx_signals[signalId];
+    /* Return the value from the latest consistent snapshot */
+    Com_RxSignalSetType received;
+    IocRead_ComRx(&received);
+    *(uint32*)signalData = received.values[signalId];
     
     return E_OK;
 }
 
+/* Decide whether a PDU goes out in this main function call */
+static boolean PduTransmissionDue(uint32 configIndex, uint64 now) {
+    Com_PduIdType pduId = pdu_config[configIndex].pduId;
+    uint64 period = (uint64)pdu_config[configIndex].txPeriod * 1000000u;
+    Com_TxModeType mode = pdu_config[configIndex].txMode;
+    boolean due = FALSE;
+    
+    /* Direct and mixed mode: send on every update */
+    if (mode != COM_TX_MODE_PERIODIC && tx_buffers[pduId].pending) {
+        due = TRUE;
+    }
+    
+    /* Periodic and mixed mode: send on the period grid once first written */
+    if (mode != COM_TX_MODE_DIRECT && period != 0u) {
+        if (next_tx_ns[pduId] == 0u && tx_buffers[pduId].pending) {
+            next_tx_ns[pduId] = now;
+        }
+        if (next_tx_ns[pduId] != 0u && now >= next_tx_ns[pduId]) {
+            due = TRUE;
+            next_tx_ns[pduId] += period;
+            if (next_tx_ns[pduId] <= now) {
+                /* Main function ran late - skip the missed periods */
+                next_tx_ns[pduId] = now + period;
+            }
+        }
+    }
+    
+    return due;
+}
+
 void Com_MainFunctionTx(void) {
-    /* Simulate periodic transmission */
-    static uint32 cycle_counter = 0;
-    cycle_counter++;
+    /* Periodic timing runs on the 64-bit OS time base */
+    uint64 now = Os_GetTimeNs();
+    Com_TxSignalUpdateType update;
+    Std_ReturnType received;
+    
+    /* Cache and pack every signal sent since the last call */
+    while ((received = IocReceive_ComTx(&update)) == IOC_E_OK || received == IOC_E_LOST_DATA) {
+        tx_signals[update.signalId] = update.value;
+        PackSignalIntoPdu(update.signalId, update.value);
+    }
     
     /* Check each PDU for transmission */
-    for (uint32 i = 0; i < COM_IPDU_COUNT; i++) {
-        if (tx_buffers[i].pending) {
+    for (uint32 c = 0; c < sizeof(pdu_config) / sizeof(pdu_config[0]); c++) {
+        Com_PduIdType i = pdu_config[c].pduId;
+        
+        if (PduTransmissionDue(c, now)) {
+            Os_TraceEvent(OS_TRACE_PDU_TX, i, tx_buffers[i].canId);
+            
             /* Simulate bus transmission */
             const char* bus_name = (tx_buffers[i].busType == COM_BUS_CAN) ? "CAN" : "LIN";
             
@@ -227,6 +313,7 @@ void Com_RxIndication(Com_PduIdType pduId, const uint8* pduData, uint8 pduLength
         return;
     }
     
+    Os_TraceEvent(OS_TRACE_PDU_RX, pduId, pduLength);
     printf("[COM] RX Indication PDU %u: [", pduId);
     for (uint8 i = 0; i < pduLength; i++) {
         printf("%02X ", pduData[i]);
@@ -246,6 +333,11 @@ void Com_RxIndication(Com_PduIdType pduId, const uint8* pduData, uint8 pduLength
         }
     }
     
+    /* Publish all signals at once, so readers never mix two receptions */
+    Com_RxSignalSetType received;
+    memcpy(received.values, rx_signals, sizeof(received.values));
+    IocWrite_ComRx(&received);
+    
     /* In real AUTOSAR:
      * - Validate DLC (Data Length Code)
      * - Check signal ranges
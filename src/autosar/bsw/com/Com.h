@@ -74,10 +74,11 @@ Std_ReturnType Com_Init(void);
 
 /**
  * @brief Send a signal over the bus
- * @details Packs signal into appropriate PDU and schedules transmission
+ * @details Queues the value on an IOC channel; the next Com_MainFunctionTx()
+ * packs it into its PDU and schedules transmission. Callable from any core.
  * @param signalId Signal identifier
  * @param signalData Pointer to signal data
- * @return E_OK if successful
+ * @return E_OK if successful, E_NOT_OK if the TX queue is full
  */
 Std_ReturnType Com_SendSignal(Com_SignalIdType signalId, const void* signalData);
 
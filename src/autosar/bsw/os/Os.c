@@ -6,24 +6,249 @@
  * Location: src/autosar/bsw/os/Os.c
  */
 
-#define _POSIX_C_SOURCE 200809L
-#define _DEFAULT_SOURCE
+#define _GNU_SOURCE
 
 #include "Os.h"
+#include "Os_Internal.h"
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
 #include <time.h>
 #include <unistd.h>
 
+/* Upper bound for one idle sleep when no task is due (absolute mode); only a
+ * guard, every new activation, alarm or shutdown wakes the sleeper itself */
+#define OS_IDLE_MAX_SLEEP_NS 1000000000u
+
+/* CPU load buckets: 10 ms each, enough for the longest window */
+#define OS_LOAD_BUCKET_NS 10000000u
+#define OS_LOAD_BUCKETS (OS_CPU_LOAD_MAX_WINDOW_MS / 10u + 1u)
+
+#define OS_NS_PER_MS 1000000u
+
+/* Linux SCHED_DEADLINE, see sched_setattr(2) - glibc has no wrapper */
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+
+typedef struct {
+    uint32_t size;
+    uint32_t sched_policy;
+    uint64_t sched_flags;
+    int32_t sched_nice;
+    uint32_t sched_priority;
+    uint64_t sched_runtime;         /* ns, all three */
+    uint64_t sched_deadline;
+    uint64_t sched_period;
+} Os_SchedAttrType;
+
+/* Event bit reserved by the OS to wake an extended task on Os_ActivateTask() */
+#define OS_EVENT_ACTIVATION ((EventMaskType)0x80000000u)
+
 /* Task Control Blocks */
 static TaskControlBlock tasks[TASK_COUNT];
-static uint32 system_tick = 0;
-static TaskType current_task = TASK_IDLE;
+static _Atomic uint32 system_tick = 0;
+static Os_SchedulerModeType scheduler_mode = OS_SCHED_MODE_ABSOLUTE;
+
+/* Time base; virtual time is only moved by the scheduler and Os_Delay() */
+static Os_ClockSourceType clock_source = OS_CLOCK_REALTIME;
+static _Atomic uint64_t virtual_time_ns = 0;
+
+/* Default task priorities (higher value = more urgent, rate monotonic) */
+static const uint32 default_priority[TASK_COUNT] = {
+    [TASK_IDLE]  = 0u,
+    [TASK_1MS]   = 3u,
+    [TASK_10MS]  = 2u,
+    [TASK_100MS] = 1u,
+};
+
+/* Preemptive mode: tasks on their own SCHED_FIFO thread, or yield points */
+static pthread_t task_threads[TASK_COUNT];
+static boolean task_has_thread[TASK_COUNT];
+static boolean task_realtime[TASK_COUNT];     /* Own thread runs under SCHED_FIFO */
+static boolean cooperative_preemption = FALSE;
+
+/* Futex word plus waiter count, one cache line each */
+typedef struct {
+    _Alignas(OS_CACHE_LINE_SIZE) _Atomic uint32 value;
+    _Atomic uint32 waiters;
+    _Atomic uint64_t parked;        /* Virtual time: OS_PARKED | value slept on, 0 = busy */
+} Os_WaitWordType;
+
+/* Marks a parked thread in Os_WaitWordType.parked */
+#define OS_PARKED ((uint64_t)1u << 32)
+
+/* Event word of each extended task - the futex the task sleeps on */
+static Os_WaitWordType event_slots[TASK_COUNT];
+
+/* Wake-up generation of each core scheduler, bumped on cross-core activation */
+static Os_WaitWordType core_wakeup[OS_CORE_COUNT];
+
+/* Per-thread execution context (one scheduler thread per core) */
+static _Thread_local TaskType current_task = TASK_IDLE;
+static _Thread_local CoreIdType current_core = OS_CORE_ID_MASTER;
+
+/* Execution-time monitoring of one task; updated by the thread running it */
+typedef struct {
+    pthread_mutex_t lock;           /* Guards the counters against Os_GetTaskStats() */
+    uint64_t start_ns;              /* CLOCK_MONOTONIC_RAW start of the running activation */
+    uint64_t budget_ns;             /* 0 = unlimited */
+    boolean overrun;                /* Budget already reported for this activation */
+    uint64_t total_ns;
+    uint64_t min_latency_ns;
+    uint64_t max_latency_ns;
+    Os_TaskStatsType stats;
+} Os_TaskTimingType;
+
+static Os_TaskTimingType task_timing[TASK_COUNT];
+static Os_ProtectionHookType protection_hook = NULL;
 
-/* Platform-specific tick implementation */
-static uint32 get_platform_tick_ms(void) {
+/* Time spent in activations nested into the running one (yield points) */
+static _Thread_local uint64_t nested_ns = 0;
+
+/* Resource Control Block; a task holds its resources as a stack */
+typedef struct {
+    uint32 ceiling;
+    TaskType owner;                 /* TASK_COUNT = free */
+    uint32 saved_priority;          /* Running priority of the owner before it took the resource */
+    ResourceType previous;          /* Resource taken before by the owner, OS_RESOURCE_COUNT = none */
+} ResourceControlBlock;
+
+static ResourceControlBlock resources[OS_RESOURCE_COUNT];
+
+/* Base priority of each task, raised while it holds resources */
+static uint32 running_priority[TASK_COUNT];
+static ResourceType last_resource[TASK_COUNT];
+
+/* Busy time of one core in a ring of buckets, indexed by bucket number */
+typedef struct {
+    pthread_mutex_t lock;           /* Task threads of a core account concurrently */
+    uint64 bucket[OS_LOAD_BUCKETS]; /* Bucket number held by each slot */
+    uint64 busy_ns[OS_LOAD_BUCKETS];
+} Os_CoreLoadType;
+
+static Os_CoreLoadType core_load[OS_CORE_COUNT];
+static uint64 load_start_ns = 0;    /* Os_Start() - the load is not defined before */
+static Os_IdleHookType idle_hook = NULL;
+
+/* Task hooks, see Os_SetTaskHooks() */
+static Os_TaskHookType pre_task_hook = NULL;
+static Os_TaskHookType post_task_hook = NULL;
+
+/* Nesting depth of dispatch_task() on this thread - only the outermost counts as load */
+static _Thread_local uint32 dispatch_depth = 0;
+
+/* OS-Application to core binding */
+static CoreIdType application_core[OS_APP_COUNT] = {
+    [OS_APP_SYSTEM] = OS_CORE_ID_MASTER,
+    [OS_APP_SWC]    = (OS_CORE_COUNT > 1u) ? 1u : OS_CORE_ID_MASTER,
+};
+
+/* Tasks owned by each core, built once in Os_Start() */
+static TaskType core_tasks[OS_CORE_COUNT][TASK_COUNT];
+static uint32 core_task_count[OS_CORE_COUNT];
+
+/* Multi-core startup and shutdown */
+static pthread_t core_threads[OS_CORE_COUNT];
+static pthread_barrier_t shutdown_barrier;
+static atomic_bool shutdown_requested = false;
+static uint32 activated_cores = 0;
+
+/* Raw monotonic time in ns, not slewed by NTP - for execution times */
+static uint64_t get_raw_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* OS time base: 64-bit ns of CLOCK_MONOTONIC (or virtual time), never wraps */
+static uint64 get_time_ns(void) {
     struct timespec ts;
+    if (clock_source == OS_CLOCK_VIRTUAL) {
+        return atomic_load(&virtual_time_ns);
+    }
     clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (uint32)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+    return (uint64)ts.tv_sec * 1000000000u + (uint64)ts.tv_nsec;
+}
+
+/* System counter value (1 ms ticks, wraps like any OSEK counter) at 'time_ns' */
+static TickType time_to_tick(uint64 time_ns) {
+    return (TickType)(time_ns / OS_NS_PER_MS);
+}
+
+/* Time of the next counter value 'tick' at or after 'time_ns' */
+static uint64 tick_to_time(TickType tick, uint64 time_ns) {
+    uint64 now_ms = time_ns / OS_NS_PER_MS;
+    return (now_ms + (TickType)(tick - (TickType)now_ms)) * OS_NS_PER_MS;
+}
+
+/* Block on a wait word while it still holds 'observed', at most until 'deadline_ns' */
+static void wait_on_word(Os_WaitWordType* word, uint32 observed, uint64 deadline_ns) {
+    struct timespec deadline;
+
+    /* Virtual time: no timeout, the scheduler posts an event when time is up */
+    if (clock_source == OS_CLOCK_VIRTUAL) {
+        atomic_fetch_add(&word->waiters, 1u);
+        atomic_store(&word->parked, OS_PARKED | observed);
+        if (atomic_load(&word->value) == observed &&
+            !atomic_load_explicit(&shutdown_requested, memory_order_relaxed)) {
+            syscall(SYS_futex, (uint32*)&word->value, FUTEX_WAIT_PRIVATE, observed, NULL, NULL, 0);
+        }
+        atomic_store(&word->parked, 0u);
+        atomic_fetch_sub(&word->waiters, 1u);
+        return;
+    }
+
+    if (deadline_ns <= get_time_ns()) {
+        return;
+    }
+    deadline.tv_sec = (time_t)(deadline_ns / 1000000000u);
+    deadline.tv_nsec = (long)(deadline_ns % 1000000000u);
+
+    /* Announce the waiter before re-checking, pairs with wake_word() */
+    atomic_fetch_add(&word->waiters, 1u);
+    if (atomic_load(&word->value) == observed) {
+        /* FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC timeout */
+        syscall(SYS_futex, (uint32*)&word->value, FUTEX_WAIT_BITSET_PRIVATE, observed,
+                &deadline, NULL, FUTEX_BITSET_MATCH_ANY);
+    }
+    atomic_fetch_sub(&word->waiters, 1u);
+}
+
+/* Wake all threads sleeping on a wait word (skips the syscall if none) */
+static void wake_word(Os_WaitWordType* word) {
+    if (atomic_load(&word->waiters) != 0u) {
+        syscall(SYS_futex, (uint32*)&word->value, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+/* Number of event posts so far; lets virtual time detect a settled system */
+static _Atomic uint32 event_posts = 0;
+
+/* Set event bits and wake the task if it sleeps on them */
+static void post_events(TaskType task, EventMaskType mask) {
+    atomic_fetch_add(&event_posts, 1u);
+    atomic_fetch_or(&event_slots[task].value, mask);
+    wake_word(&event_slots[task]);
+}
+
+/* Make a core's scheduler re-evaluate its tasks now */
+static void wake_core(CoreIdType core) {
+    atomic_fetch_add(&core_wakeup[core].value, 1u);
+    wake_word(&core_wakeup[core]);
+}
+
+void Os_SystemCounterArmed(void) {
+    wake_core(OS_CORE_ID_MASTER);
 }
 
 StatusType Os_Init(void) {
@@ -31,41 +256,311 @@ StatusType Os_Init(void) {
     for (uint32 i = 0; i < TASK_COUNT; i++) {
         tasks[i].id = i;
         tasks[i].state = TASK_STATE_SUSPENDED;
-        tasks[i].period_ms = 0;
+        tasks[i].activations = 0;
+        tasks[i].period_ns = 0;
         tasks[i].next_activation = 0;
-        tasks[i].func = NULL;
+        tasks[i].activation_count = 0;
+        tasks[i].runnable_count = 0;
+        tasks[i].application = OS_APP_SYSTEM;
+        tasks[i].priority = default_priority[i];
+        tasks[i].extended = FALSE;
+        tasks[i].trigger_mask = 0;
+        task_has_thread[i] = FALSE;
+        task_realtime[i] = FALSE;
+        running_priority[i] = default_priority[i];
+        last_resource[i] = OS_RESOURCE_COUNT;
+        atomic_store(&event_slots[i].value, 0u);
+        atomic_store(&event_slots[i].waiters, 0u);
+        atomic_store(&event_slots[i].parked, 0u);
         tasks[i].name = "Uninitialized";
+        
+        pthread_mutex_init(&task_timing[i].lock, NULL);
+        task_timing[i].budget_ns = 0;
+        task_timing[i].overrun = FALSE;
+        task_timing[i].total_ns = 0;
+        task_timing[i].min_latency_ns = UINT64_MAX;
+        task_timing[i].max_latency_ns = 0;
+        task_timing[i].stats = (Os_TaskStatsType){0};
     }
+    protection_hook = NULL;
     
-    system_tick = get_platform_tick_ms();
-    printf("[OS] Initialized at tick %u\n", system_tick);
+    for (uint32 r = 0; r < OS_RESOURCE_COUNT; r++) {
+        resources[r].ceiling = OS_MAX_TASK_PRIORITY;
+        resources[r].owner = TASK_COUNT;
+        resources[r].saved_priority = 0;
+        resources[r].previous = OS_RESOURCE_COUNT;
+    }
+    Os_SpinlockInit();
+    Os_IocInit();
+    Os_JobPoolInit();
+    Os_CoroutineInit();
+    Os_TraceInit();
+    
+    for (uint32 c = 0; c < OS_CORE_COUNT; c++) {
+        atomic_store(&core_wakeup[c].value, 0u);
+        atomic_store(&core_wakeup[c].waiters, 0u);
+        
+        pthread_mutex_init(&core_load[c].lock, NULL);
+        for (uint32 b = 0; b < OS_LOAD_BUCKETS; b++) {
+            core_load[c].bucket[b] = 0;
+            core_load[c].busy_ns[b] = 0;
+        }
+    }
+    idle_hook = NULL;
+    pre_task_hook = NULL;
+    post_task_hook = NULL;
+    
+    atomic_store(&shutdown_requested, false);
+    atomic_store(&virtual_time_ns, 0u);
+    atomic_store(&event_posts, 0u);
+    system_tick = time_to_tick(get_time_ns());
+    Os_AlarmInit(system_tick);
+    Os_ScheduleTableInit();
+    printf("[OS] Initialized at tick %u (%u cores)\n", (uint32)system_tick, OS_CORE_COUNT);
     
     return OS_STATUS_OK;
 }
 
-StatusType Os_RegisterTask(TaskType task, TaskFunc func, uint32 period_ms, const char* name) {
+/* Append a runnable to the task's table */
+static StatusType add_runnable(TaskType task, TaskFunc func, uint32 offset_ms, const char* name) {
+    TaskControlBlock* tcb = &tasks[task];
+    
+    if (tcb->runnable_count >= OS_MAX_RUNNABLES_PER_TASK) {
+        printf("[OS] ERROR: Runnable table of task %u is full\n", task);
+        return OS_STATUS_ERROR;
+    }
+    
+    Os_RunnableType* runnable = &tcb->runnables[tcb->runnable_count];
+    runnable->func = func;
+    runnable->offset_ms = offset_ms;
+    runnable->start_activation = 0;
+    runnable->coroutine = OS_COROUTINE_COUNT;
+    runnable->name = name;
+    tcb->runnable_count++;
+    
+    return OS_STATUS_OK;
+}
+
+/* Common part of Os_RegisterTask() and Os_RegisterTaskUs() */
+static StatusType register_task(TaskType task, TaskFunc func, uint64 period_ns, const char* name) {
     if (task >= TASK_COUNT || func == NULL) {
         return OS_STATUS_ERROR;
     }
     
-    tasks[task].func = func;
-    tasks[task].period_ms = period_ms;
-    tasks[task].name = name;
-    tasks[task].state = TASK_STATE_SUSPENDED;
-    tasks[task].next_activation = system_tick + period_ms;
+    if (tasks[task].runnable_count > 0 && tasks[task].period_ns != period_ns) {
+        printf("[OS] ERROR: Task %u already runs with period %lu us\n",
+               task, (unsigned long)(tasks[task].period_ns / 1000u));
+        return OS_STATUS_ERROR;
+    }
+    
+    if (add_runnable(task, func, 0, name) != OS_STATUS_OK) {
+        return OS_STATUS_ERROR;
+    }
+    
+    if (tasks[task].runnable_count == 1) {
+        /* First runnable configures the task itself */
+        tasks[task].period_ns = period_ns;
+        tasks[task].name = name;
+        tasks[task].state = TASK_STATE_SUSPENDED;
+        tasks[task].next_activation = get_time_ns() + period_ns;
+    }
+    
+    return OS_STATUS_OK;
+}
+
+StatusType Os_RegisterTask(TaskType task, TaskFunc func, uint32 period_ms, const char* name) {
+    if (register_task(task, func, (uint64)period_ms * OS_NS_PER_MS, name) != OS_STATUS_OK) {
+        return OS_STATUS_ERROR;
+    }
     
     printf("[OS] Registered task '%s' with period %u ms\n", name, period_ms);
     
     return OS_STATUS_OK;
 }
 
+StatusType Os_RegisterTaskUs(TaskType task, TaskFunc func, uint32 period_us, const char* name) {
+    if (register_task(task, func, (uint64)period_us * 1000u, name) != OS_STATUS_OK) {
+        return OS_STATUS_ERROR;
+    }
+    
+    printf("[OS] Registered task '%s' with period %u us\n", name, period_us);
+    
+    return OS_STATUS_OK;
+}
+
+StatusType Os_RegisterRunnable(TaskType task, TaskFunc func, uint32 offset_ms, const char* name) {
+    if (task >= TASK_COUNT || func == NULL || tasks[task].runnable_count == 0) {
+        return OS_STATUS_ERROR;
+    }
+    
+    if (add_runnable(task, func, offset_ms, name) != OS_STATUS_OK) {
+        return OS_STATUS_ERROR;
+    }
+    
+    printf("[OS] Registered runnable '%s' on task '%s' (offset %u ms)\n",
+           name, tasks[task].name, offset_ms);
+    
+    return OS_STATUS_OK;
+}
+
+StatusType Os_RegisterCoroutine(TaskType task, TaskFunc func, uint32 offset_ms, const char* name) {
+    if (task >= TASK_COUNT || func == NULL || tasks[task].runnable_count == 0 ||
+        tasks[task].runnable_count >= OS_MAX_RUNNABLES_PER_TASK) {
+        return OS_STATUS_ERROR;
+    }
+    
+    uint32 coroutine = Os_CoroutineCreate(func);
+    if (coroutine >= OS_COROUTINE_COUNT) {
+        printf("[OS] ERROR: No coroutine slot left for '%s'\n", name);
+        return OS_STATUS_ERROR;
+    }
+    
+    add_runnable(task, func, offset_ms, name);
+    tasks[task].runnables[tasks[task].runnable_count - 1u].coroutine = coroutine;
+    
+    printf("[OS] Registered coroutine '%s' on task '%s' (offset %u ms)\n",
+           name, tasks[task].name, offset_ms);
+    
+    return OS_STATUS_OK;
+}
+
+static void yield_point(void);
+
+/* Check the running activation against the budget; TRUE only on the first overrun */
+static boolean budget_exceeded(TaskControlBlock* tcb) {
+    Os_TaskTimingType* timing = &task_timing[tcb->id];
+    
+    if (timing->budget_ns == 0u || timing->overrun) {
+        return FALSE;
+    }
+    if (get_raw_time_ns() - timing->start_ns - nested_ns <= timing->budget_ns) {
+        return FALSE;
+    }
+    
+    timing->overrun = TRUE;
+    return TRUE;
+}
+
+/* Report a protection error and apply the hook's decision */
+static ProtectionReturnType protection_error(TaskControlBlock* tcb, StatusType error) {
+    ProtectionReturnType action = PRO_IGNORE;
+    
+    if (protection_hook != NULL) {
+        action = protection_hook(error, tcb->id);
+    } else {
+        printf("[OS] WARNING: Task '%s' exceeded its execution budget\n", tcb->name);
+    }
+    
+    if (action == PRO_SHUTDOWN) {
+        Os_ShutdownAllCores();
+    }
+    return action;
+}
+
+/* Fold one finished activation into the task statistics */
+static void record_activation(TaskControlBlock* tcb, uint64_t exec_ns, boolean released,
+                              uint64_t latency_ns, boolean missed) {
+    Os_TaskTimingType* timing = &task_timing[tcb->id];
+    Os_TaskStatsType* stats = &timing->stats;
+    uint32 exec = (exec_ns > UINT32_MAX) ? UINT32_MAX : (uint32)exec_ns;
+    
+    pthread_mutex_lock(&timing->lock);
+    if (stats->activations == 0u || exec < stats->bcet_ns) {
+        stats->bcet_ns = exec;
+    }
+    if (exec > stats->wcet_ns) {
+        stats->wcet_ns = exec;
+    }
+    stats->activations++;
+    timing->total_ns += exec_ns;
+    stats->mean_ns = (uint32)(timing->total_ns / stats->activations);
+    
+    if (released) {
+        if (latency_ns < timing->min_latency_ns) {
+            timing->min_latency_ns = latency_ns;
+        }
+        if (latency_ns > timing->max_latency_ns) {
+            timing->max_latency_ns = latency_ns;
+        }
+        stats->max_latency_ns = (uint32)((timing->max_latency_ns > UINT32_MAX) ?
+                                         UINT32_MAX : timing->max_latency_ns);
+        stats->jitter_ns = (uint32)((timing->max_latency_ns - timing->min_latency_ns > UINT32_MAX) ?
+                                    UINT32_MAX : timing->max_latency_ns - timing->min_latency_ns);
+    }
+    if (missed) {
+        stats->deadline_misses++;
+    }
+    if (timing->overrun) {
+        stats->budget_overruns++;
+    }
+    pthread_mutex_unlock(&timing->lock);
+}
+
+/* Run all runnables of a task in one pass over its table */
+static void run_task_body(TaskControlBlock* tcb) {
+    const uint32 activation = tcb->activation_count;
+    
+    for (uint32 r = 0; r < tcb->runnable_count; r++) {
+        const Os_RunnableType* runnable = &tcb->runnables[r];
+        
+        if (activation >= runnable->start_activation) {
+            Os_TraceRecord(OS_TRACE_RUNNABLE_ENTRY, tcb->id, r, 0u, runnable->name);
+            Os_RunnableExecute(runnable);
+            Os_TraceRecord(OS_TRACE_RUNNABLE_EXIT, tcb->id, r, 0u, runnable->name);
+        }
+        
+        /* Os_TerminateTask() ends the remaining runnables of this activation */
+        if (tcb->state != TASK_STATE_RUNNING) {
+            break;
+        }
+        
+        /* Timing protection at runnable granularity */
+        if (budget_exceeded(tcb) && protection_error(tcb, OS_STATUS_PROTECTION_TIME) != PRO_IGNORE) {
+            break;
+        }
+        
+        /* Runnable boundaries are preemption points in cooperative mode */
+        yield_point();
+    }
+    
+    tcb->activation_count++;
+}
+
 StatusType Os_ActivateTask(TaskType task) {
+    TaskStateType suspended = TASK_STATE_SUSPENDED;
+    
     if (task >= TASK_COUNT) {
         return OS_STATUS_ERROR;
     }
     
-    if (tasks[task].state == TASK_STATE_SUSPENDED) {
-        tasks[task].state = TASK_STATE_READY;
+    TaskControlBlock* tcb = &tasks[task];
+    
+    if (tcb->period_ns == 0u && !tcb->extended) {
+        /* Non-periodic basic task: queue the activation; the first one makes the
+         * task ready, dispatch_task() makes it ready again for the others */
+        uint32 queued = atomic_load(&tcb->activations);
+        do {
+            if (queued >= OS_MAX_ACTIVATIONS) {
+                return OS_STATUS_LIMIT;
+            }
+        } while (!atomic_compare_exchange_weak(&tcb->activations, &queued, queued + 1u));
+        if (queued != 0u) {
+            return OS_STATUS_OK;
+        }
+        tcb->next_activation = get_time_ns();   /* Due right away */
+    }
+    
+    /* A periodic task that is ready or running keeps its period */
+    if (!atomic_compare_exchange_strong(&tcb->state, &suspended, TASK_STATE_READY) && !tcb->extended) {
+        return OS_STATUS_OK;
+    }
+    
+    /* Threaded tasks sleep on their event word, the others on their core; an
+     * extended task that is ready or waiting runs again for the activation bit */
+    if (tcb->extended || task_has_thread[task]) {
+        post_events(task, OS_EVENT_ACTIVATION);
+    } else {
+        wake_core(application_core[tcb->application]);
     }
     
     return OS_STATUS_OK;
@@ -78,53 +573,949 @@ StatusType Os_TerminateTask(void) {
     return OS_STATUS_OK;
 }
 
+StatusType Os_SetTaskExtended(TaskType task, EventMaskType trigger_mask) {
+    if (task >= TASK_COUNT || (trigger_mask & OS_EVENT_ACTIVATION) != 0u) {
+        return OS_STATUS_ERROR;
+    }
+    
+    tasks[task].extended = TRUE;
+    tasks[task].trigger_mask = trigger_mask;
+    return OS_STATUS_OK;
+}
+
+StatusType Os_SetEvent(TaskType task, EventMaskType mask) {
+    if (task >= TASK_COUNT || !tasks[task].extended || (mask & OS_EVENT_ACTIVATION) != 0u) {
+        return OS_STATUS_ERROR;
+    }
+    
+    post_events(task, mask);
+    return OS_STATUS_OK;
+}
+
+StatusType Os_ClearEvent(EventMaskType mask) {
+    if (current_task >= TASK_COUNT || !tasks[current_task].extended) {
+        return OS_STATUS_ERROR;
+    }
+    
+    atomic_fetch_and(&event_slots[current_task].value, ~(mask & ~OS_EVENT_ACTIVATION));
+    return OS_STATUS_OK;
+}
+
+StatusType Os_GetEvent(TaskType task, EventMaskRefType event) {
+    if (task >= TASK_COUNT || event == NULL || !tasks[task].extended) {
+        return OS_STATUS_ERROR;
+    }
+    
+    *event = atomic_load(&event_slots[task].value) & ~OS_EVENT_ACTIVATION;
+    return OS_STATUS_OK;
+}
+
+StatusType Os_WaitEvent(EventMaskType mask) {
+    if (current_task >= TASK_COUNT || !tasks[current_task].extended || mask == 0u) {
+        return OS_STATUS_ERROR;
+    }
+    
+    TaskControlBlock* tcb = &tasks[current_task];
+    Os_WaitWordType* slot = &event_slots[current_task];
+    
+    tcb->state = TASK_STATE_WAITING;
+    for (;;) {
+        uint32 observed = atomic_load(&slot->value);
+        if ((observed & mask) != 0u ||
+            atomic_load_explicit(&shutdown_requested, memory_order_relaxed)) {
+            break;
+        }
+        wait_on_word(slot, observed, get_time_ns() + OS_IDLE_MAX_SLEEP_NS);
+    }
+    tcb->state = TASK_STATE_RUNNING;
+    
+    return OS_STATUS_OK;
+}
+
+StatusType Os_SetSchedulerMode(Os_SchedulerModeType mode) {
+    if (mode != OS_SCHED_MODE_POLLING && mode != OS_SCHED_MODE_ABSOLUTE &&
+        mode != OS_SCHED_MODE_PREEMPTIVE && mode != OS_SCHED_MODE_DEADLINE) {
+        return OS_STATUS_ERROR;
+    }
+
+    scheduler_mode = mode;
+    return OS_STATUS_OK;
+}
+
+StatusType Os_SetTaskPriority(TaskType task, uint32 priority) {
+    if (task >= TASK_COUNT || priority > OS_MAX_TASK_PRIORITY) {
+        return OS_STATUS_ERROR;
+    }
+    
+    tasks[task].priority = priority;
+    return OS_STATUS_OK;
+}
+
+StatusType Os_GetTaskStats(TaskType task, Os_TaskStatsType* stats) {
+    if (task >= TASK_COUNT || stats == NULL) {
+        return OS_STATUS_ERROR;
+    }
+    
+    pthread_mutex_lock(&task_timing[task].lock);
+    *stats = task_timing[task].stats;
+    pthread_mutex_unlock(&task_timing[task].lock);
+    return OS_STATUS_OK;
+}
+
+StatusType Os_SetTaskBudget(TaskType task, uint32 budget_us) {
+    if (task >= TASK_COUNT) {
+        return OS_STATUS_ERROR;
+    }
+    
+    task_timing[task].budget_ns = (uint64_t)budget_us * 1000u;
+    return OS_STATUS_OK;
+}
+
+void Os_SetProtectionHook(Os_ProtectionHookType hook) {
+    protection_hook = hook;
+}
+
+void Os_SetIdleHook(Os_IdleHookType hook) {
+    idle_hook = hook;
+}
+
+void Os_SetTaskHooks(Os_TaskHookType pre, Os_TaskHookType post) {
+    pre_task_hook = pre;
+    post_task_hook = post;
+}
+
+/* Book the busy interval [start_ns, end_ns) on a core, split over its buckets */
+static void account_busy(CoreIdType core, uint64 start_ns, uint64 end_ns) {
+    Os_CoreLoadType* load = &core_load[core];
+    
+    pthread_mutex_lock(&load->lock);
+    while (start_ns < end_ns) {
+        uint64 bucket = start_ns / OS_LOAD_BUCKET_NS;
+        uint64 bucket_end = (bucket + 1u) * OS_LOAD_BUCKET_NS;
+        uint32 slot = (uint32)(bucket % OS_LOAD_BUCKETS);
+        uint64 until = (end_ns < bucket_end) ? end_ns : bucket_end;
+        
+        /* The slot still holds a bucket from one ring lap ago */
+        if (load->bucket[slot] != bucket) {
+            load->bucket[slot] = bucket;
+            load->busy_ns[slot] = 0;
+        }
+        load->busy_ns[slot] += until - start_ns;
+        start_ns = until;
+    }
+    pthread_mutex_unlock(&load->lock);
+}
+
+StatusType Os_GetCpuLoad(CoreIdType core, uint32 window_ms, uint32* load_permille) {
+    if (core >= OS_CORE_COUNT || window_ms == 0u || window_ms > OS_CPU_LOAD_MAX_WINDOW_MS ||
+        load_permille == NULL) {
+        return OS_STATUS_ERROR;
+    }
+    
+    Os_CoreLoadType* load = &core_load[core];
+    uint64 now = get_time_ns();
+    uint64 last = now / OS_LOAD_BUCKET_NS;
+    uint64 count = ((uint64)window_ms * OS_NS_PER_MS + OS_LOAD_BUCKET_NS - 1u) / OS_LOAD_BUCKET_NS;
+    uint64 first = (last + 1u > count) ? last + 1u - count : 0u;
+    uint64 window_start = first * OS_LOAD_BUCKET_NS;
+    uint64 busy = 0;
+    
+    if (window_start < load_start_ns) {
+        window_start = load_start_ns;
+    }
+    
+    pthread_mutex_lock(&load->lock);
+    for (uint64 bucket = first; bucket <= last; bucket++) {
+        uint32 slot = (uint32)(bucket % OS_LOAD_BUCKETS);
+        if (load->bucket[slot] == bucket) {
+            busy += load->busy_ns[slot];
+        }
+    }
+    pthread_mutex_unlock(&load->lock);
+    
+    /* An activation ending now may have started before the window - clamp */
+    if (now <= window_start) {
+        *load_permille = 0;
+    } else {
+        busy *= 1000u;
+        *load_permille = (busy >= (now - window_start) * 1000u) ? 1000u :
+                         (uint32)(busy / (now - window_start));
+    }
+    
+    return OS_STATUS_OK;
+}
+
+/* Nothing due on the calling core until its next wake-up */
+static void enter_idle(CoreIdType core) {
+    if (idle_hook != NULL) {
+        idle_hook(core);
+    }
+}
+
+StatusType Os_SetApplicationCore(ApplicationType app, CoreIdType core) {
+    if (app >= OS_APP_COUNT || core >= OS_CORE_COUNT) {
+        return OS_STATUS_ERROR;
+    }
+    
+    application_core[app] = core;
+    return OS_STATUS_OK;
+}
+
+StatusType Os_SetTaskApplication(TaskType task, ApplicationType app) {
+    if (task >= TASK_COUNT || app >= OS_APP_COUNT) {
+        return OS_STATUS_ERROR;
+    }
+    
+    tasks[task].application = app;
+    return OS_STATUS_OK;
+}
+
+TaskType Os_GetCurrentTask(void) {
+    return current_task;
+}
+
+CoreIdType Os_GetCoreID(void) {
+    return current_core;
+}
+
+uint32 Os_GetNumberOfActivatedCores(void) {
+    return activated_cores;
+}
+
+void Os_ShutdownAllCores(void) {
+    /* Only atomics and futex wakes: safe to call from a task or a signal handler */
+    atomic_store(&shutdown_requested, true);
+    
+    /* Idle cores and task threads sleep without a tick - wake them to leave */
+    for (CoreIdType c = 0; c < OS_CORE_COUNT; c++) {
+        wake_core(c);
+    }
+    for (uint32 i = 0; i < TASK_COUNT; i++) {
+        if (task_has_thread[i]) {
+            post_events(i, OS_EVENT_ACTIVATION);
+        }
+    }
+}
+
 uint32 Os_GetTick(void) {
     return system_tick;
 }
 
+uint64 Os_GetTick64(void) {
+    return get_time_ns() / OS_NS_PER_MS;
+}
+
+uint64 Os_GetTimeNs(void) {
+    return get_time_ns();
+}
+
 void Os_Delay(uint32 ms) {
+    if (clock_source == OS_CLOCK_VIRTUAL) {
+        atomic_fetch_add(&virtual_time_ns, (uint64)ms * OS_NS_PER_MS);
+        return;
+    }
     usleep(ms * 1000);
 }
 
-void Os_Start(void) {
-    printf("[OS] Starting scheduler...\n");
-    printf("[OS] Tick resolution: 1ms\n\n");
+StatusType Os_SetClockSource(Os_ClockSourceType source) {
+    if (source != OS_CLOCK_REALTIME && source != OS_CLOCK_VIRTUAL) {
+        return OS_STATUS_ERROR;
+    }
     
-    /* Activate all registered tasks */
-    for (uint32 i = 0; i < TASK_COUNT; i++) {
-        if (tasks[i].func != NULL) {
-            Os_ActivateTask(i);
+    clock_source = source;
+    return OS_STATUS_OK;
+}
+
+/* Advance a task to its next activation after it ran at 'now' */
+static void schedule_next_activation(TaskControlBlock* tcb, uint64 now) {
+    if (scheduler_mode == OS_SCHED_MODE_POLLING) {
+        tcb->next_activation = now + tcb->period_ns;
+        return;
+    }
+    
+    /* Advance on the period grid; skip activations already missed */
+    uint64 period = (tcb->period_ns != 0u) ? tcb->period_ns : OS_NS_PER_MS;
+    tcb->next_activation += period;
+    while (now >= tcb->next_activation) {
+        tcb->next_activation += period;
+    }
+}
+
+static void release_leaked_resources(TaskControlBlock* tcb);
+
+/* Run one activation of a task; nests when called from a yield point */
+static void dispatch_task(TaskControlBlock* tcb, uint64 now, boolean periodic) {
+    TaskType preempted = current_task;
+    Os_TaskTimingType* timing = &task_timing[tcb->id];
+    uint64_t outer_nested_ns = nested_ns;
+    uint64_t start_ns = get_time_ns();
+    uint64_t release_ns = (tcb->next_activation <= start_ns) ? tcb->next_activation : start_ns;
+    
+    current_task = tcb->id;
+    tcb->state = TASK_STATE_RUNNING;
+    dispatch_depth++;
+    
+    nested_ns = 0;
+    timing->overrun = FALSE;
+    timing->start_ns = get_raw_time_ns();
+    running_priority[tcb->id] = tcb->priority;
+    
+    Os_TraceRecord(OS_TRACE_TASK_START, tcb->id, tcb->id, tcb->activation_count, tcb->name);
+    if (pre_task_hook != NULL) {
+        pre_task_hook(tcb->id);
+    }
+    run_task_body(tcb);
+    if (post_task_hook != NULL) {
+        post_task_hook(tcb->id);
+    }
+    release_leaked_resources(tcb);
+    Os_TraceRecord(OS_TRACE_TASK_END, tcb->id, tcb->id, 0u, tcb->name);
+    
+    /* Statistics exclude the activations nested into this one */
+    uint64_t elapsed_ns = get_raw_time_ns() - timing->start_ns;
+    boolean missed = periodic && tcb->period_ns != 0u &&
+                     get_time_ns() - release_ns > tcb->period_ns;
+    record_activation(tcb, elapsed_ns - nested_ns, periodic, start_ns - release_ns, missed);
+    nested_ns = outer_nested_ns + elapsed_ns;
+    
+    /* Nested activations are inside the busy time of the outermost one. Booked as
+     * measured host time from the start on the OS time base, which in virtual
+     * time does not advance while the task runs */
+    if (--dispatch_depth == 0u) {
+        account_busy(current_core, start_ns, start_ns + elapsed_ns);
+    }
+    
+    /* Task completed - schedule next activation */
+    if (tcb->period_ns == 0u && !tcb->extended) {
+        /* Non-periodic basic task: one run per Os_ActivateTask(), terminated or not.
+         * Suspend before dropping this activation, so an activator that finds none
+         * left queued sees the task suspended and makes it ready itself */
+        tcb->state = TASK_STATE_SUSPENDED;
+        if (atomic_fetch_sub(&tcb->activations, 1u) > 1u) {
+            tcb->next_activation = get_time_ns();
+            tcb->state = TASK_STATE_READY;
+        }
+    } else if (tcb->state == TASK_STATE_RUNNING) {
+        tcb->state = TASK_STATE_READY;
+        if (periodic) {
+            schedule_next_activation(tcb, now);
         }
     }
     
-    /* Main scheduler loop */
-    while (1) {
+    current_task = preempted;
+}
+
+/* Cooperative preemption: run due tasks of this core that outrank the caller */
+static void yield_point(void) {
+    if (!cooperative_preemption || Os_SpinlockHeld() ||
+        (current_task < TASK_COUNT && task_has_thread[current_task])) {
+        return;
+    }
+    
+    const uint32 current_priority = (current_task < TASK_COUNT) ? running_priority[current_task] : 0u;
+    const TaskType* owned = core_tasks[current_core];
+    uint64 now = get_time_ns();
+    
+    /* core_tasks is sorted by descending priority */
+    for (uint32 k = 0; k < core_task_count[current_core]; k++) {
+        TaskControlBlock* tcb = &tasks[owned[k]];
+        
+        if (tcb->priority <= current_priority) {
+            break;
+        }
+        
+        if (tcb->state == TASK_STATE_READY && now >= tcb->next_activation) {
+            dispatch_task(tcb, now, TRUE);
+        }
+    }
+}
+
+StatusType Os_Schedule(void) {
+    yield_point();
+    return OS_STATUS_OK;
+}
+
+/* SCHED_FIFO priority of an OS priority */
+static int fifo_priority(uint32 priority) {
+    int min_prio = sched_get_priority_min(SCHED_FIFO);
+    int max_prio = sched_get_priority_max(SCHED_FIFO);
+    
+    return (min_prio + (int)priority > max_prio) ? max_prio : min_prio + (int)priority;
+}
+
+/* Apply the running priority to a task on its own SCHED_FIFO thread */
+static void apply_running_priority(TaskType task) {
+    if (task_realtime[task]) {
+        pthread_setschedprio(task_threads[task], fifo_priority(running_priority[task]));
+    }
+}
+
+StatusType Os_SetResourceCeiling(ResourceType res, uint32 ceiling) {
+    if (res >= OS_RESOURCE_COUNT || ceiling > OS_MAX_TASK_PRIORITY ||
+        resources[res].owner != TASK_COUNT) {
+        return OS_STATUS_ERROR;
+    }
+    
+    resources[res].ceiling = ceiling;
+    return OS_STATUS_OK;
+}
+
+StatusType Os_GetResource(ResourceType res) {
+    TaskType task = current_task;
+    
+    if (res >= OS_RESOURCE_COUNT || task >= TASK_COUNT) {
+        return OS_STATUS_ERROR;
+    }
+    
+    ResourceControlBlock* rcb = &resources[res];
+    
+    /* A task above the ceiling could be preempted by another holder */
+    if (rcb->owner != TASK_COUNT || tasks[task].priority > rcb->ceiling) {
+        printf("[OS] ERROR: Task '%s' cannot take resource %u\n", tasks[task].name, res);
+        return OS_STATUS_ERROR;
+    }
+    
+    rcb->owner = task;
+    rcb->saved_priority = running_priority[task];
+    rcb->previous = last_resource[task];
+    last_resource[task] = res;
+    
+    if (rcb->ceiling > running_priority[task]) {
+        running_priority[task] = rcb->ceiling;
+        apply_running_priority(task);
+    }
+    
+    return OS_STATUS_OK;
+}
+
+StatusType Os_ReleaseResource(ResourceType res) {
+    TaskType task = current_task;
+    
+    if (res >= OS_RESOURCE_COUNT || task >= TASK_COUNT || last_resource[task] != res) {
+        return OS_STATUS_ERROR;
+    }
+    
+    ResourceControlBlock* rcb = &resources[res];
+    
+    last_resource[task] = rcb->previous;
+    running_priority[task] = rcb->saved_priority;
+    rcb->owner = TASK_COUNT;
+    apply_running_priority(task);
+    
+    /* Rescheduling point: run the tasks the ceiling held off */
+    yield_point();
+    
+    return OS_STATUS_OK;
+}
+
+/* A task must not end while holding resources - release them for it */
+static void release_leaked_resources(TaskControlBlock* tcb) {
+    while (last_resource[tcb->id] != OS_RESOURCE_COUNT) {
+        ResourceControlBlock* rcb = &resources[last_resource[tcb->id]];
+        
+        printf("[OS] ERROR: Task '%s' ended holding resource %u\n", tcb->name, last_resource[tcb->id]);
+        last_resource[tcb->id] = rcb->previous;
+        running_priority[tcb->id] = rcb->saved_priority;
+        rcb->owner = TASK_COUNT;
+    }
+    apply_running_priority(tcb->id);
+}
+
+/* Scheduler loop of one core - returns once shutdown is requested */
+static void core_schedule(CoreIdType core) {
+    const TaskType* owned = core_tasks[core];
+    const uint32 owned_count = core_task_count[core];
+    
+    while (!atomic_load_explicit(&shutdown_requested, memory_order_relaxed)) {
+        /* Snapshot the wake-up generation before looking at task states */
+        uint32 wakeup = atomic_load(&core_wakeup[core].value);
+        
         /* Update system tick */
-        system_tick = get_platform_tick_ms();
+        uint64 now = get_time_ns();
+        atomic_store_explicit(&system_tick, time_to_tick(now), memory_order_relaxed);
+        uint64 next_wakeup = now + OS_IDLE_MAX_SLEEP_NS;
+        
+        /* The master core drives the system counter and its alarms */
+        if (core == OS_CORE_ID_MASTER) {
+            TickType expiry;
+            Os_CounterAdvance(OS_COUNTER_SYSTEM, time_to_tick(now));
+            if (Os_CounterNextExpiry(OS_COUNTER_SYSTEM, &expiry) &&
+                tick_to_time(expiry, now) < next_wakeup) {
+                next_wakeup = tick_to_time(expiry, now);
+            }
+        }
+        
+        /* Check each task of this core for activation, highest priority first */
+        for (uint32 k = 0; k < owned_count; k++) {
+            TaskControlBlock* tcb = &tasks[owned[k]];
+            
+            if (tcb->state != TASK_STATE_READY) {
+                continue;
+            }
+            
+            if (now >= tcb->next_activation) {
+                dispatch_task(tcb, now, TRUE);
+            }
+            
+            /* Track the earliest pending deadline */
+            if (tcb->state == TASK_STATE_READY && tcb->next_activation < next_wakeup) {
+                next_wakeup = tcb->next_activation;
+            }
+        }
+        
+        if (scheduler_mode != OS_SCHED_MODE_POLLING) {
+            /* Tickless: sleep until the earliest absolute deadline (no accumulated overshoot) */
+            if (next_wakeup > get_time_ns()) {
+                enter_idle(core);
+            }
+            wait_on_word(&core_wakeup[core], wakeup, next_wakeup);
+        } else {
+            /* Sleep to reduce CPU usage (cooperative scheduling) */
+            enter_idle(core);
+            Os_Delay(1);
+        }
+    }
+}
+
+/* Host CPU backing an emulated core */
+static int host_cpu_of(CoreIdType core) {
+    long host_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return (int)(core % (uint32)((host_cpus > 0) ? host_cpus : 1));
+}
+
+/* Pin the calling thread to the host CPU backing an emulated core */
+static void pin_to_core(CoreIdType core) {
+    int cpu = host_cpu_of(core);
+    cpu_set_t set;
+    
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        printf("[OS] WARNING: Core %u could not be pinned to CPU %d\n", core, cpu);
+        return;
+    }
+    
+    printf("[OS] Core %u running on CPU %d with %u task(s)\n", core, cpu, core_task_count[core]);
+}
+
+/* Thread entry of a task running under SCHED_FIFO */
+static void* task_thread_main(void* arg) {
+    TaskControlBlock* tcb = &tasks[(TaskType)(uintptr_t)arg];
+    Os_WaitWordType* slot = &event_slots[tcb->id];
+    
+    current_core = application_core[tcb->application];
+    
+    while (!atomic_load_explicit(&shutdown_requested, memory_order_relaxed)) {
+        /* Os_ActivateTask() posts the activation bit to wake this thread */
+        uint32 observed = atomic_fetch_and(&slot->value, ~OS_EVENT_ACTIVATION) & ~OS_EVENT_ACTIVATION;
+        uint64 now = get_time_ns();
+        
+        if (tcb->state == TASK_STATE_READY && now >= tcb->next_activation) {
+            dispatch_task(tcb, now, TRUE);
+        }
+        
+        wait_on_word(slot, observed, (tcb->state == TASK_STATE_READY) ?
+                     tcb->next_activation : now + OS_IDLE_MAX_SLEEP_NS);
+    }
+    
+    return NULL;
+}
+
+/* Thread entry of an extended task - sleeps on its event word between activations */
+static void* extended_task_main(void* arg) {
+    TaskControlBlock* tcb = &tasks[(TaskType)(uintptr_t)arg];
+    Os_WaitWordType* slot = &event_slots[tcb->id];
+    
+    current_core = application_core[tcb->application];
+    
+    while (!atomic_load_explicit(&shutdown_requested, memory_order_relaxed)) {
+        uint64 now = get_time_ns();
+        uint32 pending = atomic_load(&slot->value);
+        boolean triggered = (pending & (tcb->trigger_mask | OS_EVENT_ACTIVATION)) != 0u;
+        boolean due = tcb->period_ns != 0u && now >= tcb->next_activation;
+        
+        if (tcb->state == TASK_STATE_READY && (triggered || due)) {
+            atomic_fetch_and(&slot->value, ~OS_EVENT_ACTIVATION);
+            dispatch_task(tcb, now, due);
+            
+            /* Consume the trigger events seen at activation; newer ones re-trigger */
+            atomic_fetch_and(&slot->value, ~(pending & tcb->trigger_mask));
+            continue;
+        }
+        
+        wait_on_word(slot, pending,
+                       (tcb->state == TASK_STATE_READY && tcb->period_ns != 0u) ?
+                       tcb->next_activation : now + OS_IDLE_MAX_SLEEP_NS);
+    }
+    
+    return NULL;
+}
+
+/* Give a task its own thread; realtime (SCHED_FIFO) fails without privileges */
+static boolean start_task_thread(TaskControlBlock* tcb, boolean realtime) {
+    pthread_attr_t attr;
+    struct sched_param param;
+    cpu_set_t set;
+    int err;
+    
+    param.sched_priority = fifo_priority(tcb->priority);
+    
+    CPU_ZERO(&set);
+    CPU_SET(host_cpu_of(application_core[tcb->application]), &set);
+    
+    pthread_attr_init(&attr);
+    if (realtime) {
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &param);
+    }
+    pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+    
+    err = pthread_create(&task_threads[tcb->id], &attr,
+                         tcb->extended ? extended_task_main : task_thread_main,
+                         (void*)(uintptr_t)tcb->id);
+    pthread_attr_destroy(&attr);
+    
+    if (err != 0) {
+        printf("[OS] WARNING: No %s thread for task '%s' (%s)\n",
+               realtime ? "SCHED_FIFO" : "dedicated", tcb->name,
+               (err == EPERM) ? "no realtime privileges" : "pthread_create failed");
+        return FALSE;
+    }
+    
+    if (realtime) {
+        printf("[OS] Task '%s' preemptive at SCHED_FIFO priority %d\n", tcb->name, param.sched_priority);
+    } else {
+        printf("[OS] Extended task '%s' running on its own thread\n", tcb->name);
+    }
+    return TRUE;
+}
+
+/* Handshake between start_deadline_thread() and the new thread */
+typedef struct {
+    TaskType task;
+    sem_t ready;
+    int err;                        /* sched_setattr() result, 0 or errno */
+} DeadlineStartType;
+
+/* SCHED_DEADLINE runtime of a task: its budget, else a share of its period */
+static uint64 deadline_runtime(const TaskControlBlock* tcb) {
+    uint64 budget = task_timing[tcb->id].budget_ns;
+    
+    if (budget == 0u) {
+        return tcb->period_ns * OS_DEADLINE_RUNTIME_PERCENT / 100u;
+    }
+    return (budget < tcb->period_ns) ? budget : tcb->period_ns;
+}
+
+/* Thread entry of a periodic task under SCHED_DEADLINE */
+static void* deadline_task_main(void* arg) {
+    DeadlineStartType* start = arg;
+    TaskType task = start->task;
+    TaskControlBlock* tcb = &tasks[task];
+    Os_SchedAttrType attr = {
+        .size = sizeof(Os_SchedAttrType),
+        .sched_policy = SCHED_DEADLINE,
+        .sched_runtime = deadline_runtime(tcb),
+        .sched_deadline = tcb->period_ns,
+        .sched_period = tcb->period_ns,
+    };
+    
+    start->err = (syscall(SYS_sched_setattr, 0, &attr, 0u) == 0) ? 0 : errno;
+    boolean admitted = (start->err == 0);
+    sem_post(&start->ready);    /* 'start' is gone after this */
+    
+    if (!admitted) {
+        return NULL;
+    }
+    
+    /* Sleeps until each activation like any task thread; the kernel
+     * guarantees the runtime in every period */
+    return task_thread_main((void*)(uintptr_t)task);
+}
+
+/* Give a periodic task a SCHED_DEADLINE thread; fails without privileges or admission */
+static boolean start_deadline_thread(TaskControlBlock* tcb) {
+    DeadlineStartType start = { .task = tcb->id, .err = 0 };
+    pthread_t thread;
+    
+    sem_init(&start.ready, 0, 0);
+    if (pthread_create(&thread, NULL, deadline_task_main, &start) != 0) {
+        sem_destroy(&start.ready);
+        printf("[OS] WARNING: No SCHED_DEADLINE thread for task '%s' (pthread_create failed)\n",
+               tcb->name);
+        return FALSE;
+    }
+    while (sem_wait(&start.ready) != 0) {
+        /* Interrupted by a signal - keep waiting */
+    }
+    sem_destroy(&start.ready);
+    
+    if (start.err != 0) {
+        pthread_join(thread, NULL);
+        printf("[OS] WARNING: No SCHED_DEADLINE thread for task '%s' (%s)\n", tcb->name,
+               (start.err == EPERM) ? "no CAP_SYS_NICE" :
+               (start.err == EBUSY) ? "not admitted" : strerror(start.err));
+        return FALSE;
+    }
+    
+    task_threads[tcb->id] = thread;
+    printf("[OS] Task '%s' under SCHED_DEADLINE (runtime %lu us, period %lu us)\n", tcb->name,
+           (unsigned long)(deadline_runtime(tcb) / 1000u), (unsigned long)(tcb->period_ns / 1000u));
+    return TRUE;
+}
+
+/* Virtual time: wait until every extended task is parked on an unchanged event word */
+static void wait_extended_tasks_blocked(void) {
+    boolean settled;
+    
+    do {
+        /* A full pass without any event post in between */
+        uint32 posts = atomic_load(&event_posts);
+        settled = TRUE;
         
-        /* Check each task for activation */
         for (uint32 i = 0; i < TASK_COUNT; i++) {
-            if (tasks[i].state == TASK_STATE_READY && 
-                tasks[i].func != NULL &&
-                system_tick >= tasks[i].next_activation) {
-                
-                /* Run the task */
-                current_task = i;
-                tasks[i].state = TASK_STATE_RUNNING;
-                
-                tasks[i].func();
-                
-                /* Task completed - schedule next activation */
-                if (tasks[i].state == TASK_STATE_RUNNING) {
-                    tasks[i].state = TASK_STATE_READY;
-                    tasks[i].next_activation = system_tick + tasks[i].period_ms;
+            if (!tasks[i].extended || !task_has_thread[i]) {
+                continue;
+            }
+            
+            uint64_t parked = atomic_load(&event_slots[i].parked);
+            while (parked == 0u || (uint32)parked != atomic_load(&event_slots[i].value)) {
+                /* Tasks leave their loop on shutdown instead of parking */
+                if (atomic_load_explicit(&shutdown_requested, memory_order_relaxed)) {
+                    return;
                 }
+                sched_yield();
+                parked = atomic_load(&event_slots[i].parked);
+            }
+        }
+        
+        if (atomic_load(&event_posts) != posts) {
+            settled = FALSE;
+        }
+    } while (!settled);
+}
+
+/* Virtual time: run every core in turn on this thread, then jump to the next due time */
+static void virtual_schedule(void) {
+    while (!atomic_load_explicit(&shutdown_requested, memory_order_relaxed)) {
+        uint64 now = get_time_ns();
+        uint64 next_wakeup = now + OS_IDLE_MAX_SLEEP_NS;
+        TickType expiry;
+        
+        atomic_store_explicit(&system_tick, time_to_tick(now), memory_order_relaxed);
+        current_core = OS_CORE_ID_MASTER;
+        Os_CounterAdvance(OS_COUNTER_SYSTEM, time_to_tick(now));
+        
+        /* Due periodic extended tasks are woken through their event word */
+        for (uint32 i = 0; i < TASK_COUNT; i++) {
+            if (tasks[i].extended && task_has_thread[i] && tasks[i].state == TASK_STATE_READY &&
+                tasks[i].period_ns != 0u && now >= tasks[i].next_activation) {
+                post_events(i, OS_EVENT_ACTIVATION);
+            }
+        }
+        wait_extended_tasks_blocked();
+        
+        /* Same order as each core would pick them: highest priority first */
+        for (CoreIdType c = 0; c < OS_CORE_COUNT; c++) {
+            current_core = c;
+            for (uint32 k = 0; k < core_task_count[c]; k++) {
+                TaskControlBlock* tcb = &tasks[core_tasks[c][k]];
                 
-                current_task = TASK_IDLE;
+                if (tcb->state == TASK_STATE_READY && now >= tcb->next_activation) {
+                    dispatch_task(tcb, now, TRUE);
+                    wait_extended_tasks_blocked();
+                }
+            }
+        }
+        current_core = OS_CORE_ID_MASTER;
+        
+        /* Earliest pending activation or alarm expiry */
+        for (uint32 i = 0; i < TASK_COUNT; i++) {
+            const TaskControlBlock* tcb = &tasks[i];
+            
+            if (tcb->runnable_count > 0u && tcb->state == TASK_STATE_READY &&
+                (!tcb->extended || tcb->period_ns != 0u) && tcb->next_activation < next_wakeup) {
+                next_wakeup = tcb->next_activation;
+            }
+        }
+        if (Os_CounterNextExpiry(OS_COUNTER_SYSTEM, &expiry) && tick_to_time(expiry, now) < next_wakeup) {
+            next_wakeup = tick_to_time(expiry, now);
+        }
+        
+        /* Jump (Os_Delay() may already have moved time past it) */
+        if (get_time_ns() < next_wakeup &&
+            !atomic_load_explicit(&shutdown_requested, memory_order_relaxed)) {
+            for (CoreIdType c = 0; c < OS_CORE_COUNT; c++) {
+                current_core = c;
+                enter_idle(c);
+            }
+            current_core = OS_CORE_ID_MASTER;
+            atomic_store(&virtual_time_ns, next_wakeup);
+        }
+    }
+}
+
+/* Thread entry of every core */
+static void* core_main(void* arg) {
+    CoreIdType core = (CoreIdType)(uintptr_t)arg;
+    
+    current_core = core;
+    pin_to_core(core);
+    core_schedule(core);
+    
+    /* All cores leave the OS together */
+    pthread_barrier_wait(&shutdown_barrier);
+    return NULL;
+}
+
+/* Timing summary of every task that ran, and of each core */
+static void print_task_stats(void) {
+    for (uint32 i = 0; i < TASK_COUNT; i++) {
+        Os_TaskStatsType stats;
+        
+        Os_GetTaskStats(i, &stats);
+        if (stats.activations == 0u) {
+            continue;
+        }
+        printf("[OS] Task '%s': %u runs, exec min/mean/max %u/%u/%u us, "
+               "latency max %u us, jitter %u us, %u deadline miss(es), %u overrun(s)\n",
+               tasks[i].name, stats.activations, stats.bcet_ns / 1000u, stats.mean_ns / 1000u,
+               stats.wcet_ns / 1000u, stats.max_latency_ns / 1000u, stats.jitter_ns / 1000u,
+               stats.deadline_misses, stats.budget_overruns);
+    }
+    
+    for (CoreIdType c = 0; c < activated_cores; c++) {
+        uint32 load;
+        
+        Os_GetCpuLoad(c, OS_CPU_LOAD_MAX_WINDOW_MS, &load);
+        printf("[OS] Core %u load over the last %u s: %u.%u%%\n",
+               c, OS_CPU_LOAD_MAX_WINDOW_MS / 1000u, load / 10u, load % 10u);
+    }
+}
+
+void Os_Start(void) {
+    printf("[OS] Starting scheduler...\n");
+    printf("[OS] Time base: 64-bit ns (%s time), system counter 1 ms\n",
+           (clock_source == OS_CLOCK_VIRTUAL) ? "virtual" : "real");
+    printf("[OS] Mode: %s\n", (scheduler_mode == OS_SCHED_MODE_POLLING) ? "polling" :
+           (scheduler_mode == OS_SCHED_MODE_ABSOLUTE) ? "absolute deadlines" :
+           (scheduler_mode == OS_SCHED_MODE_PREEMPTIVE) ? "preemptive" : "SCHED_DEADLINE");
+    
+    /* Activate all registered tasks and hand them to their core */
+    for (uint32 c = 0; c < OS_CORE_COUNT; c++) {
+        core_task_count[c] = 0;
+    }
+    cooperative_preemption = FALSE;
+    load_start_ns = get_time_ns();
+    
+    for (uint32 i = 0; i < TASK_COUNT; i++) {
+        if (tasks[i].runnable_count > 0) {
+            /* Offsets are rounded up to whole task periods */
+            for (uint32 r = 0; r < tasks[i].runnable_count; r++) {
+                Os_RunnableType* runnable = &tasks[i].runnables[r];
+                uint64 period = (tasks[i].period_ns != 0u) ? tasks[i].period_ns : OS_NS_PER_MS;
+                uint64 offset = (uint64)runnable->offset_ms * OS_NS_PER_MS;
+                runnable->start_activation = (uint32)((offset + period - 1u) / period);
+            }
+            
+            if (tasks[i].extended) {
+                /* Extended tasks wait for their first trigger event or period */
+                tasks[i].state = TASK_STATE_READY;
+            } else {
+                Os_ActivateTask(i);
+            }
+            
+            if (scheduler_mode == OS_SCHED_MODE_PREEMPTIVE && clock_source == OS_CLOCK_VIRTUAL) {
+                /* Threads would race virtual time - preempt at runnable boundaries */
+                cooperative_preemption = TRUE;
+            } else if (scheduler_mode == OS_SCHED_MODE_PREEMPTIVE) {
+                task_has_thread[i] = start_task_thread(&tasks[i], TRUE);
+                task_realtime[i] = task_has_thread[i];
+                if (!task_has_thread[i]) {
+                    cooperative_preemption = TRUE;
+                }
+            } else if (scheduler_mode == OS_SCHED_MODE_DEADLINE && clock_source != OS_CLOCK_VIRTUAL &&
+                       tasks[i].period_ns != 0u && !tasks[i].extended) {
+                /* Refused tasks stay in the absolute loop of their core */
+                task_has_thread[i] = start_deadline_thread(&tasks[i]);
+            }
+            
+            /* Extended tasks must be able to block in Os_WaitEvent() */
+            if (tasks[i].extended && !task_has_thread[i]) {
+                task_has_thread[i] = start_task_thread(&tasks[i], FALSE);
+                if (!task_has_thread[i]) {
+                    printf("[OS] ERROR: Extended task '%s' cannot be started\n", tasks[i].name);
+                }
+            }
+            
+            if (task_has_thread[i] || tasks[i].extended) {
+                continue;
             }
+            
+            /* Insert into the core's list, sorted by descending priority */
+            CoreIdType core = application_core[tasks[i].application];
+            uint32 k = core_task_count[core]++;
+            while (k > 0 && tasks[core_tasks[core][k - 1]].priority < tasks[i].priority) {
+                core_tasks[core][k] = core_tasks[core][k - 1];
+                k--;
+            }
+            core_tasks[core][k] = i;
         }
+    }
+    
+    Os_JobPoolStart();
+    
+    if (clock_source == OS_CLOCK_VIRTUAL) {
+        printf("\n");
+        activated_cores = OS_CORE_COUNT;
+        virtual_schedule();
         
-        /* Sleep to reduce CPU usage (cooperative scheduling) */
-        Os_Delay(1);
+        /* Extended tasks sleep without timeout - a post makes them see the shutdown */
+        for (uint32 i = 0; i < TASK_COUNT; i++) {
+            if (task_has_thread[i]) {
+                post_events(i, OS_EVENT_ACTIVATION);
+                pthread_join(task_threads[i], NULL);
+                task_has_thread[i] = FALSE;
+            }
+        }
+        
+        Os_JobPoolStop();
+        printf("[OS] Virtual time stopped at %lu ms\n", (unsigned long)Os_GetTick64());
+        print_task_stats();
+        Os_PrintSpinlockStats();
+        return;
     }
-}
\ No newline at end of file
+    
+    /* Start the secondary cores; the calling thread becomes the master core */
+    pthread_barrier_init(&shutdown_barrier, NULL, OS_CORE_COUNT);
+    activated_cores = 1;
+    for (uint32 c = 1; c < OS_CORE_COUNT; c++) {
+        if (pthread_create(&core_threads[c], NULL, core_main, (void*)(uintptr_t)c) != 0) {
+            /* The shutdown barrier expects every core - cannot run degraded */
+            printf("[OS] ERROR: Failed to start core %u\n", c);
+            exit(1);
+        }
+        activated_cores++;
+    }
+    printf("\n");
+    
+    core_main((void*)(uintptr_t)OS_CORE_ID_MASTER);
+    
+    for (uint32 c = 1; c < activated_cores; c++) {
+        pthread_join(core_threads[c], NULL);
+    }
+    for (uint32 i = 0; i < TASK_COUNT; i++) {
+        if (task_has_thread[i]) {
+            pthread_join(task_threads[i], NULL);
+            task_has_thread[i] = FALSE;
+            task_realtime[i] = FALSE;
+        }
+    }
+    pthread_barrier_destroy(&shutdown_barrier);
+    Os_JobPoolStop();
+    
+    printf("[OS] All cores shut down\n");
+    print_task_stats();
+    Os_PrintSpinlockStats();
+}
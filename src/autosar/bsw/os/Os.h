@@ -20,32 +20,338 @@ typedef enum {
     TASK_COUNT
 } TaskType;
 
+/* Number of emulated cores - each runs its own scheduler thread */
+#ifndef OS_CORE_COUNT
+#define OS_CORE_COUNT 2u
+#endif
+
+/* Core identifiers */
+typedef uint32 CoreIdType;
+#define OS_CORE_ID_MASTER ((CoreIdType)0u)
+
+/* OS-Applications - every task belongs to one, every application to one core */
+typedef enum {
+    OS_APP_SYSTEM = 0,   /* BSW tasks (COM, ...) - master core by default */
+    OS_APP_SWC,          /* Application SWC tasks - core 1 by default */
+    OS_APP_COUNT
+} ApplicationType;
+
 /* Task States */
 typedef enum {
     TASK_STATE_SUSPENDED = 0,
     TASK_STATE_READY,
-    TASK_STATE_RUNNING
+    TASK_STATE_RUNNING,
+    TASK_STATE_WAITING          /* Extended task blocked in Os_WaitEvent() */
 } TaskStateType;
 
+/* Event masks for extended tasks (bit 31 is reserved by the OS) */
+typedef uint32 EventMaskType;
+typedef EventMaskType* EventMaskRefType;
+
 /* Task function pointer */
 typedef void (*TaskFunc)(void);
 
+/* Activations of a non-periodic basic task that may be queued, the running one included */
+#ifndef OS_MAX_ACTIVATIONS
+#define OS_MAX_ACTIVATIONS 8u
+#endif
+
+/* Maximum number of runnables mapped onto a single task */
+#ifndef OS_MAX_RUNNABLES_PER_TASK
+#define OS_MAX_RUNNABLES_PER_TASK 16u
+#endif
+
+/* Stackful coroutine runnables, see Os_RegisterCoroutine() */
+#ifndef OS_COROUTINE_COUNT
+#define OS_COROUTINE_COUNT 8u
+#endif
+
+#ifndef OS_COROUTINE_STACK_SIZE
+#define OS_COROUTINE_STACK_SIZE (64u * 1024u)
+#endif
+
+/* Runnable entry - executed in registration order on every task activation */
+typedef struct {
+    TaskFunc func;
+    uint32 offset_ms;           /* Delay before the first execution */
+    uint32 start_activation;    /* offset_ms expressed in task activations */
+    uint32 coroutine;           /* Coroutine slot, OS_COROUTINE_COUNT = plain function */
+    const char* name;
+} Os_RunnableType;
+
+/*
+ * Stackless coroutine helpers for plain runnables: the runnable returns at
+ * OS_COROUTINE_YIELD() and continues after it on its next execution. 'state'
+ * is a static uint32 of the runnable, locals that live across a yield must
+ * be static too, and no yield may sit inside a switch statement.
+ */
+#define OS_COROUTINE_BEGIN(state)   switch (state) { case 0:
+#define OS_COROUTINE_YIELD(state)   do { (state) = __LINE__; return; case __LINE__:; } while (0)
+#define OS_COROUTINE_END(state)     } (state) = 0
+
 /* Task Control Block */
 typedef struct {
     TaskType id;
-    TaskStateType state;
-    uint32 period_ms;
-    uint32 next_activation;
-    TaskFunc func;
+    _Atomic TaskStateType state;    /* Changed by activators on any thread */
+    _Atomic uint32 activations;     /* Queued activations of a non-periodic basic task */
+    uint64 period_ns;           /* 0 = activated by Os_ActivateTask() only */
+    uint64 next_activation;     /* Absolute OS time in ns, see Os_GetTimeNs(); written
+                                 * only by whoever makes the task READY */
+    uint32 activation_count;
+    uint32 runnable_count;
+    Os_RunnableType runnables[OS_MAX_RUNNABLES_PER_TASK];
+    ApplicationType application;
+    uint32 priority;            /* Higher value = more urgent */
+    boolean extended;           /* Runs on its own thread, may wait for events */
+    EventMaskType trigger_mask; /* Events that activate the extended task */
     const char* name;
 } TaskControlBlock;
 
+/* Highest priority accepted by Os_SetTaskPriority() */
+#define OS_MAX_TASK_PRIORITY 31u
+
+/* Scheduler modes */
+typedef enum {
+    OS_SCHED_MODE_POLLING = 0,   /* Poll all tasks, then sleep 1ms (relative) */
+    OS_SCHED_MODE_ABSOLUTE,      /* Sleep until the earliest absolute deadline */
+    OS_SCHED_MODE_PREEMPTIVE,    /* Per-task SCHED_FIFO threads, else yield points */
+    OS_SCHED_MODE_DEADLINE       /* Periodic tasks on SCHED_DEADLINE threads, else absolute */
+} Os_SchedulerModeType;
+
+/* SCHED_DEADLINE runtime of a task without budget, in percent of its period */
+#ifndef OS_DEADLINE_RUNTIME_PERCENT
+#define OS_DEADLINE_RUNTIME_PERCENT 10u
+#endif
+
+/* Time base of the OS */
+typedef enum {
+    OS_CLOCK_REALTIME = 0,       /* CLOCK_MONOTONIC, tasks run at wall-clock pace */
+    OS_CLOCK_VIRTUAL             /* Simulated time, jumps to the next activation */
+} Os_ClockSourceType;
+
+/* Counter ticks */
+typedef uint32 TickType;
+typedef TickType* TickRefType;
+
+/* Counters - each drives its own timer wheel of alarms */
+typedef enum {
+    OS_COUNTER_SYSTEM = 0,       /* Driven by the master core, 1 tick = 1 ms */
+    OS_COUNTER_SOFTWARE,         /* Driven by Os_IncrementCounter() */
+    OS_COUNTER_COUNT
+} CounterType;
+
+/* Number of alarm objects (AlarmType 0 .. OS_ALARM_COUNT-1) */
+#ifndef OS_ALARM_COUNT
+#define OS_ALARM_COUNT 64u
+#endif
+
+typedef uint32 AlarmType;
+
+/* Alarm expiry actions */
+typedef enum {
+    OS_ALARM_ACTION_ACTIVATETASK = 0,
+    OS_ALARM_ACTION_SETEVENT,
+    OS_ALARM_ACTION_CALLBACK
+} Os_AlarmActionType;
+
+/* Alarm callback, runs in the context of the thread advancing the counter */
+typedef void (*Os_AlarmCallbackType)(AlarmType alarm);
+
+/* Alarm configuration */
+typedef struct {
+    CounterType counter;
+    Os_AlarmActionType action;
+    TaskType task;                  /* ACTIVATETASK / SETEVENT */
+    EventMaskType event;            /* SETEVENT */
+    Os_AlarmCallbackType callback;  /* CALLBACK */
+} Os_AlarmConfigType;
+
+/* Schedule tables - static lists of expiry points driven by a counter */
+#ifndef OS_SCHEDULETABLE_COUNT
+#define OS_SCHEDULETABLE_COUNT 4u
+#endif
+
+typedef uint32 ScheduleTableType;
+
+typedef enum {
+    SCHEDULETABLE_STOPPED = 0,
+    SCHEDULETABLE_RUNNING
+} ScheduleTableStatusType;
+
+typedef ScheduleTableStatusType* ScheduleTableStatusRefType;
+
+/* One action of an expiry point; several entries may share an offset */
+typedef struct {
+    TickType offset;                /* Ticks from the start of the table */
+    TaskType task;
+    EventMaskType event;            /* 0 = Os_ActivateTask(), else Os_SetEvent() */
+} Os_ExpiryPointType;
+
+/* Schedule table configuration */
+typedef struct {
+    CounterType counter;
+    TickType duration;              /* Length of one round in ticks */
+    boolean repeating;              /* Restart after duration, else stop after the last point */
+    const Os_ExpiryPointType* points; /* Sorted by offset, all offsets < duration */
+    uint32 point_count;
+} Os_ScheduleTableConfigType;
+
 /* OS Status */
 typedef enum {
     OS_STATUS_OK = 0,
-    OS_STATUS_ERROR
+    OS_STATUS_ERROR,
+    OS_STATUS_PROTECTION_TIME,  /* A task exceeded its execution budget */
+    OS_STATUS_LIMIT             /* Too many activations queued */
 } StatusType;
 
+/* Execution-time statistics of one task, see Os_GetTaskStats() */
+typedef struct {
+    uint32 activations;         /* Completed activations */
+    uint32 bcet_ns;             /* Best-case execution time */
+    uint32 wcet_ns;             /* Worst-case execution time */
+    uint32 mean_ns;             /* Mean execution time */
+    uint32 max_latency_ns;      /* Worst start delay after the planned activation */
+    uint32 jitter_ns;           /* Spread of the start delay (max - min) */
+    uint32 deadline_misses;     /* Finished after its next periodic activation */
+    uint32 budget_overruns;     /* Activations that exceeded the budget */
+} Os_TaskStatsType;
+
+/* What the OS does after a protection error */
+typedef enum {
+    PRO_IGNORE = 0,             /* Let the task finish */
+    PRO_TERMINATETASKISR,       /* Skip the remaining runnables of this activation */
+    PRO_SHUTDOWN                /* Os_ShutdownAllCores() */
+} ProtectionReturnType;
+
+/* Protection hook, runs on the thread of the offending task */
+typedef ProtectionReturnType (*Os_ProtectionHookType)(StatusType fatal_error, TaskType task);
+
+/* Idle hook, runs on a core each time it has no task due */
+typedef void (*Os_IdleHookType)(CoreIdType core);
+
+/* Pre-/post-task hook, runs on the thread of the task around each activation */
+typedef void (*Os_TaskHookType)(TaskType task);
+
+/* Background job and its completion callback, both run on a pool thread */
+typedef void (*Os_JobFuncType)(void* arg);
+
+/* Background job pool threads, see Os_SubmitJob() */
+#ifndef OS_JOB_WORKER_COUNT
+#define OS_JOB_WORKER_COUNT 2u
+#endif
+
+/* Jobs queued per pool thread, and jobs queued from tasks (powers of two) */
+#define OS_JOB_QUEUE_LENGTH 256u
+
+/* Longest window of Os_GetCpuLoad() */
+#define OS_CPU_LOAD_MAX_WINDOW_MS 10000u
+
+/* Resources: OSEK immediate priority ceiling, exclusion between tasks of one core */
+typedef enum {
+    RES_SCHEDULER = 0,          /* Ceiling OS_MAX_TASK_PRIORITY - no preemption on the core */
+    OS_RESOURCE_COUNT
+} ResourceType;
+
+/* Spinlocks: exclusion between cores */
+typedef enum {
+    OS_SPINLOCK_SWC = 0,        /* SWC data shared between cores */
+    OS_SPINLOCK_COUNT
+} SpinlockIdType;
+
+typedef enum {
+    TRYTOGETSPINLOCK_NOSUCCESS = 0,
+    TRYTOGETSPINLOCK_SUCCESS
+} TryToGetSpinlockType;
+
+/* Contention statistics of one spinlock, see Os_GetSpinlockStats() */
+typedef struct {
+    uint32 acquisitions;        /* Successful Os_GetSpinlock() / Os_TryToGetSpinlock() */
+    uint32 contended;           /* Acquisitions that found the lock taken */
+    uint32 sleeps;              /* Waits that exhausted the spin budget and slept */
+    uint32 max_wait_ns;         /* Longest wait for the lock */
+    uint64 spins;               /* Busy-wait iterations over all acquisitions */
+} Os_SpinlockStatsType;
+
+/* IOC channels (Inter-OS-Application Communicator) */
+typedef enum {
+    OS_IOC_COM_TX = 0,          /* Queued: signals sent by the SWCs to COM */
+    OS_IOC_COM_RX,              /* Last-is-best: bus signals received by COM */
+    OS_IOC_COUNT
+} IocChannelType;
+
+/* Largest IOC element; a queue slot plus its sequence word fills one cache line */
+#define OS_IOC_MAX_DATA_SIZE 56u
+
+/* Longest IOC queue (power of two) */
+#ifndef OS_IOC_MAX_QUEUE_LENGTH
+#define OS_IOC_MAX_QUEUE_LENGTH 64u
+#endif
+
+/* IOC return values (Std_ReturnType) */
+#define IOC_E_OK        E_OK
+#define IOC_E_NOK       E_NOT_OK
+#define IOC_E_LOST_DATA ((Std_ReturnType)64u)   /* Data received, but the queue overflowed before */
+#define IOC_E_LIMIT     ((Std_ReturnType)130u)  /* Queue full, the element was dropped */
+#define IOC_E_NO_DATA   ((Std_ReturnType)131u)  /* Queue empty */
+
+/* IOC communication semantics */
+typedef enum {
+    OS_IOC_QUEUED = 0,          /* Os_IocSend() / Os_IocReceive(), FIFO */
+    OS_IOC_UNQUEUED             /* Os_IocWrite() / Os_IocRead(), last is best */
+} Os_IocSemanticsType;
+
+/* IOC channel configuration */
+typedef struct {
+    Os_IocSemanticsType semantics;
+    uint32 data_size;           /* Bytes per element, 1..OS_IOC_MAX_DATA_SIZE */
+    uint32 queue_length;        /* Queued only: power of two, <= OS_IOC_MAX_QUEUE_LENGTH */
+    boolean multi_sender;       /* Senders on more than one task or core */
+} Os_IocConfigType;
+
+/**
+ * @brief Generate the typed IOC functions of a queued channel
+ * @details IocSend_<Name>(const Type*) and IocReceive_<Name>(Type*), as the
+ * AUTOSAR generator would.
+ */
+#define OS_IOC_DEFINE_QUEUED(Name, channel, Type) \
+    _Static_assert(sizeof(Type) <= OS_IOC_MAX_DATA_SIZE, "IOC element too large"); \
+    static inline Std_ReturnType IocSend_##Name(const Type* data) { \
+        return Os_IocSend((channel), data); \
+    } \
+    static inline Std_ReturnType IocReceive_##Name(Type* data) { \
+        return Os_IocReceive((channel), data); \
+    }
+
+/**
+ * @brief Generate the typed IOC functions of a last-is-best channel
+ * @details IocWrite_<Name>(const Type*) and IocRead_<Name>(Type*).
+ */
+#define OS_IOC_DEFINE_UNQUEUED(Name, channel, Type) \
+    _Static_assert(sizeof(Type) <= OS_IOC_MAX_DATA_SIZE, "IOC element too large"); \
+    static inline Std_ReturnType IocWrite_##Name(const Type* data) { \
+        return Os_IocWrite((channel), data); \
+    } \
+    static inline Std_ReturnType IocRead_##Name(Type* data) { \
+        return Os_IocRead((channel), data); \
+    }
+
+/* Trace events kept per core; older ones are overwritten (power of two) */
+#ifndef OS_TRACE_BUFFER_SIZE
+#define OS_TRACE_BUFFER_SIZE 16384u
+#endif
+
+/* Trace events, see Os_StartTrace() */
+typedef enum {
+    OS_TRACE_TASK_START = 0,    /* id = task, value = activation count */
+    OS_TRACE_TASK_END,          /* id = task */
+    OS_TRACE_RUNNABLE_ENTRY,    /* id = runnable index in its task */
+    OS_TRACE_RUNNABLE_EXIT,     /* id = runnable index in its task */
+    OS_TRACE_SIGNAL_WRITE,      /* id = RTE signal, value = first 32 bits written */
+    OS_TRACE_PDU_TX,            /* id = PDU, value = bus ID */
+    OS_TRACE_PDU_RX,            /* id = PDU, value = length */
+    OS_TRACE_EVENT_COUNT
+} Os_TraceEventType;
+
 /**
  * @brief Initialize the OS
  * @return OS_STATUS_OK if successful
@@ -54,17 +360,127 @@ StatusType Os_Init(void);
 
 /**
  * @brief Start the OS scheduler
- * @details Never returns - runs forever
+ * @details Starts one pinned scheduler thread per core; the calling thread
+ * becomes the master core. Returns only after Os_ShutdownAllCores() once
+ * every core has reached the shutdown barrier.
  */
 void Os_Start(void);
 
+/**
+ * @brief Request shutdown of all cores
+ * @details Each core finishes its current task, then all cores meet at the
+ * shutdown barrier. Async-signal-safe.
+ */
+void Os_ShutdownAllCores(void);
+
+/**
+ * @brief Get the core the caller is running on
+ * @return Core identifier (OS_CORE_ID_MASTER outside of scheduler threads)
+ */
+CoreIdType Os_GetCoreID(void);
+
+/**
+ * @brief Get the number of cores started by Os_Start()
+ * @return Number of running cores
+ */
+uint32 Os_GetNumberOfActivatedCores(void);
+
+/**
+ * @brief Bind an OS-Application to a core
+ * @details Must be called before Os_Start()
+ * @param app OS-Application
+ * @param core Core identifier (< OS_CORE_COUNT)
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_SetApplicationCore(ApplicationType app, CoreIdType core);
+
+/**
+ * @brief Assign a task to an OS-Application
+ * @details Must be called before Os_Start(). Tasks default to OS_APP_SYSTEM.
+ * @param task Task ID
+ * @param app OS-Application
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_SetTaskApplication(TaskType task, ApplicationType app);
+
 /**
  * @brief Activate a task
+ * @details Safe from any thread. A non-periodic basic task runs once per
+ * activation: activations that arrive while it is ready or running are
+ * queued, up to OS_MAX_ACTIVATIONS. A periodic task activated while ready
+ * or running just keeps its period; an extended task runs once more.
  * @param task Task to activate
- * @return OS_STATUS_OK if successful
+ * @return OS_STATUS_OK if successful, OS_STATUS_LIMIT if OS_MAX_ACTIVATIONS
+ * activations are queued already
  */
 StatusType Os_ActivateTask(TaskType task);
 
+/**
+ * @brief Yield point for cooperative preemption
+ * @details In OS_SCHED_MODE_PREEMPTIVE without realtime privileges, runs any
+ * due task of the calling core with a higher priority before returning.
+ * The OS also yields between the runnables of a task. No-op otherwise.
+ * @return OS_STATUS_OK
+ */
+StatusType Os_Schedule(void);
+
+/**
+ * @brief Turn a registered task into an OSEK extended task
+ * @details Must be called before Os_Start(). Extended tasks run on their own
+ * thread and sleep on a futex while waiting, so they use no CPU when idle.
+ * The task is activated by its period (if non-zero), by Os_ActivateTask()
+ * and whenever an event of trigger_mask is set. Trigger events pending at
+ * activation are cleared once the activation completes.
+ * @param task Task ID
+ * @param trigger_mask Events that activate the task (0 = none)
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_SetTaskExtended(TaskType task, EventMaskType trigger_mask);
+
+/**
+ * @brief Set events of an extended task
+ * @details Wakes the task if it waits for any of them. Callable from any
+ * thread or core.
+ * @param task Extended task to signal
+ * @param mask Events to set
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if task is not extended
+ */
+StatusType Os_SetEvent(TaskType task, EventMaskType mask);
+
+/**
+ * @brief Clear events of the calling extended task
+ * @param mask Events to clear
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR outside an extended task
+ */
+StatusType Os_ClearEvent(EventMaskType mask);
+
+/**
+ * @brief Get the current events of an extended task
+ * @param task Extended task
+ * @param event Pointer to store the event mask
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_GetEvent(TaskType task, EventMaskRefType event);
+
+/**
+ * @brief Block the calling extended task until one of the events is set
+ * @details The task is TASK_STATE_WAITING and consumes no CPU meanwhile.
+ * Events are not cleared - use Os_ClearEvent(). Returns early on shutdown.
+ * @param mask Events to wait for
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR outside an extended task
+ */
+StatusType Os_WaitEvent(EventMaskType mask);
+
+/**
+ * @brief Set the priority of a task
+ * @details Must be called before Os_Start(). Defaults are rate monotonic:
+ * TASK_1MS > TASK_10MS > TASK_100MS.
+ * @param task Task ID
+ * @param priority Priority, 0..OS_MAX_TASK_PRIORITY (higher = more urgent)
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_SetTaskPriority(TaskType task, uint32 priority);
+
 /**
  * @brief Terminate the calling task
  * @return OS_STATUS_OK if successful
@@ -73,18 +489,73 @@ StatusType Os_TerminateTask(void);
 
 /**
  * @brief Get current tick count (in ms)
+ * @details 32-bit value of the last scheduler pass; wraps after ~49 days.
+ * Use Os_GetTick64() or Os_GetTimeNs() to measure or compare times.
  * @return Current system tick
  */
 uint32 Os_GetTick(void);
 
+/**
+ * @brief Get the current OS time in ms (64-bit, does not wrap)
+ * @return Milliseconds since the OS time base origin
+ */
+uint64 Os_GetTick64(void);
+
+/**
+ * @brief Get the current OS time in ns (64-bit, does not wrap)
+ * @details CLOCK_MONOTONIC, or the virtual clock (see Os_SetClockSource()).
+ * Task activations are planned on this time base.
+ * @return Nanoseconds since the OS time base origin
+ */
+uint64 Os_GetTimeNs(void);
+
 /**
  * @brief Delay for specified milliseconds
  * @param ms Milliseconds to delay
  */
 void Os_Delay(uint32 ms);
 
+/**
+ * @brief Select the time base
+ * @details Must be called before Os_Init(). With OS_CLOCK_VIRTUAL, time
+ * starts at 0 and only moves when nothing is due: the scheduler jumps
+ * straight to the next task activation or alarm expiry instead of sleeping.
+ * All cores are then simulated in core order on the thread calling
+ * Os_Start(), each running its due tasks by priority as in real time;
+ * preemptive mode falls back to yield points. Extended tasks keep their
+ * thread and time only advances once all of them are blocked. Execution
+ * times in Os_GetTaskStats() stay real; Os_Delay() advances virtual time.
+ * @param source OS_CLOCK_REALTIME (default) or OS_CLOCK_VIRTUAL
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_SetClockSource(Os_ClockSourceType source);
+
+/**
+ * @brief Select the scheduler loop strategy
+ * @details Must be called before Os_Start(). The default is
+ * OS_SCHED_MODE_ABSOLUTE: the scheduler sleeps until the earliest
+ * next_activation of all tasks (absolute CLOCK_MONOTONIC timeout) and
+ * advances each task by exactly one period, so activations do not drift.
+ *
+ * OS_SCHED_MODE_DEADLINE gives every periodic basic task a thread under
+ * Linux SCHED_DEADLINE with period and relative deadline equal to the task
+ * period and the task budget (Os_SetTaskBudget(), else
+ * OS_DEADLINE_RUNTIME_PERCENT of the period) as runtime, so the kernel
+ * guarantees the rate under background load. This needs CAP_SYS_NICE and a
+ * utilization the kernel admits; tasks it refuses, and all tasks under
+ * OS_CLOCK_VIRTUAL, stay in the absolute loop of their core. Deadline
+ * threads cannot be pinned to a core's host CPU, and resources do not
+ * exclude them from each other.
+ * @param mode Scheduler mode
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_SetSchedulerMode(Os_SchedulerModeType mode);
+
 /**
  * @brief Register a task with the scheduler
+ * @details Sets the task period and appends func to the task's runnable
+ * table. Calling it again for the same task adds another runnable instead
+ * of replacing the first one; the period must then match.
  * @param task Task ID
  * @param func Task function pointer
  * @param period_ms Task period in milliseconds
@@ -93,4 +564,418 @@ void Os_Delay(uint32 ms);
  */
 StatusType Os_RegisterTask(TaskType task, TaskFunc func, uint32 period_ms, const char* name);
 
+/**
+ * @brief Register a task with a period in microseconds
+ * @details Same as Os_RegisterTask() for sub-millisecond periods, e.g.
+ * 100 us or 500 us control loops.
+ * @param task Task ID
+ * @param func Task function pointer
+ * @param period_us Task period in microseconds
+ * @param name Task name for debugging
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_RegisterTaskUs(TaskType task, TaskFunc func, uint32 period_us, const char* name);
+
+/**
+ * @brief Append a runnable to an already registered task
+ * @details Runnables run in registration order within one task activation.
+ * The offset delays the first execution and is rounded up to whole task
+ * periods, which allows staggering runnables that share a task.
+ * @param task Task ID
+ * @param func Runnable function pointer
+ * @param offset_ms Delay before the first execution in milliseconds
+ * @param name Runnable name for debugging
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if the table is full
+ */
+StatusType Os_RegisterRunnable(TaskType task, TaskFunc func, uint32 offset_ms, const char* name);
+
+/**
+ * @brief Append a stackful coroutine runnable to an already registered task
+ * @details The runnable gets its own stack of OS_COROUTINE_STACK_SIZE bytes
+ * and may call Os_Yield() anywhere, also in nested functions: it then
+ * resumes there on the next activation of its task, while the remaining
+ * runnables of the current activation run as usual. Once the function
+ * returns, the next activation starts it from the beginning again. No
+ * thread is involved; the coroutine always runs on its task's thread.
+ * @param task Task ID
+ * @param func Runnable function pointer
+ * @param offset_ms Delay before the first execution in milliseconds
+ * @param name Runnable name for debugging
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if the runnable
+ * table or the OS_COROUTINE_COUNT coroutine slots are full
+ */
+StatusType Os_RegisterCoroutine(TaskType task, TaskFunc func, uint32 offset_ms, const char* name);
+
+/**
+ * @brief Suspend the calling coroutine runnable until the next activation
+ * @return OS_STATUS_OK once resumed, OS_STATUS_ERROR if the caller is not
+ * a coroutine runnable
+ */
+StatusType Os_Yield(void);
+
+/* ============================================
+ * Timing Monitoring and Protection
+ * ============================================ */
+
+/**
+ * @brief Get the execution-time statistics of a task
+ * @details Execution times are measured with CLOCK_MONOTONIC_RAW around each
+ * activation, minus the time spent in tasks that preempted it through a
+ * yield point. Tasks on their own SCHED_FIFO thread are measured in wall
+ * time, including preemption by higher-priority threads. Start delay and
+ * deadline use the planned activation tick on CLOCK_MONOTONIC; the deadline
+ * of a periodic task is its next activation, event-driven tasks have none.
+ * @param task Task ID
+ * @param stats Pointer to store the statistics
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_GetTaskStats(TaskType task, Os_TaskStatsType* stats);
+
+/**
+ * @brief Set the execution budget of a task
+ * @details The budget is checked after every runnable; the first check that
+ * finds it exceeded calls the protection hook with OS_STATUS_PROTECTION_TIME.
+ * @param task Task ID
+ * @param budget_us Budget per activation in microseconds, 0 = unlimited
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_SetTaskBudget(TaskType task, uint32 budget_us);
+
+/**
+ * @brief Install the protection hook
+ * @details Without a hook, budget overruns are logged and ignored.
+ * @param hook Hook function, NULL to remove it
+ */
+void Os_SetProtectionHook(Os_ProtectionHookType hook);
+
+/**
+ * @brief Install the idle hook
+ * @details Called on a core's scheduler thread right before it sleeps until
+ * its next activation, alarm expiry or cross-core wake-up. Must not block.
+ * @param hook Hook function, NULL to remove it
+ */
+void Os_SetIdleHook(Os_IdleHookType hook);
+
+/**
+ * @brief Install the pre-task and post-task hooks
+ * @details The pre-task hook runs right before the first runnable of every
+ * task activation, the post-task hook right after the last one, both on
+ * the thread of the task and inside its execution time.
+ * @param pre Pre-task hook, NULL for none
+ * @param post Post-task hook, NULL for none
+ */
+void Os_SetTaskHooks(Os_TaskHookType pre, Os_TaskHookType post);
+
+/**
+ * @brief Get the CPU load of a core over a sliding window
+ * @details Load is the measured execution time of the core's task
+ * activations, placed at their start on the OS time base, in 10 ms buckets;
+ * an activation counts once it has ended. The window is rounded up to whole
+ * buckets and starts no earlier than Os_Start(). In virtual time this is
+ * the load the tasks would put on the core in real time, as the host needed
+ * as long for them as they would take on a real clock (clamped to 100 %).
+ * @param core Core ID
+ * @param window_ms Window ending now, 1..OS_CPU_LOAD_MAX_WINDOW_MS
+ * @param load_permille Pointer to store the load in 0.1 % units (0..1000)
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_GetCpuLoad(CoreIdType core, uint32 window_ms, uint32* load_permille);
+
+/* ============================================
+ * Background Jobs
+ * ============================================ */
+
+/**
+ * @brief Run a function in the background, outside every task
+ * @details Jobs run on a pool of OS_JOB_WORKER_COUNT threads, on host CPUs
+ * the emulated cores do not use or else under SCHED_IDLE, so they never
+ * delay a task. Each pool thread keeps its own deque: jobs submitted by a
+ * job go to the front of it, idle threads steal from the back of the
+ * others. Jobs submitted from tasks are shared by all pool threads. The
+ * pool runs from Os_Start() until shutdown and finishes every queued job
+ * before Os_Start() returns; jobs submitted earlier wait for Os_Start().
+ * @param func Job function
+ * @param arg Argument of func and done
+ * @param done Completion callback run right after func, or NULL
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if the queue is full
+ */
+StatusType Os_SubmitJob(Os_JobFuncType func, void* arg, Os_JobFuncType done);
+
+/* ============================================
+ * Tracing
+ * ============================================ */
+
+/**
+ * @brief Clear the trace buffers and start recording
+ * @details Task activations and runnables are recorded by the OS, signal
+ * writes by the RTE and PDUs by COM, each into the buffer of the core it
+ * happens on, with a host timestamp (TSC where available). Recording never
+ * blocks or allocates; a full buffer overwrites its oldest events.
+ */
+void Os_StartTrace(void);
+
+/**
+ * @brief Stop recording; the buffers are kept for Os_DumpTrace()
+ */
+void Os_StopTrace(void);
+
+/**
+ * @brief Record a trace event on the calling core
+ * @details Does nothing while the trace is stopped.
+ * @param event Event type
+ * @param id Object the event is about (signal, PDU, ...)
+ * @param value Event argument
+ */
+void Os_TraceEvent(Os_TraceEventType event, uint32 id, uint32 value);
+
+/**
+ * @brief Write the recorded events as a Chrome trace (JSON)
+ * @details Opens in Perfetto (ui.perfetto.dev) and chrome://tracing: one
+ * process per core, one track per task, runnables nested in their task
+ * activation, signal writes and PDUs as instant events. Timestamps are host
+ * time, also under OS_CLOCK_VIRTUAL. May be called while recording.
+ * @param path Output file
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if it cannot be written
+ */
+StatusType Os_DumpTrace(const char* path);
+
+/* ============================================
+ * Resources and Spinlocks
+ * ============================================ */
+
+/**
+ * @brief Set the ceiling priority of a resource
+ * @details The ceiling must be at least the priority of every task that
+ * takes the resource. Resources start with ceiling OS_MAX_TASK_PRIORITY.
+ * @param res Resource ID
+ * @param ceiling Ceiling priority, 0..OS_MAX_TASK_PRIORITY
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if the resource is held
+ */
+StatusType Os_SetResourceCeiling(ResourceType res, uint32 ceiling);
+
+/**
+ * @brief Take a resource (immediate priority ceiling protocol)
+ * @details The calling task runs at the ceiling priority until it releases
+ * the resource, so no other task of its core that takes the resource can
+ * preempt it. Resources do not exclude tasks of other cores - use a
+ * spinlock for data shared across cores.
+ * @param res Resource ID
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if the resource is
+ * held or the caller's priority is above the ceiling
+ */
+StatusType Os_GetResource(ResourceType res);
+
+/**
+ * @brief Release a resource
+ * @details Resources are released in the reverse order they were taken.
+ * Tasks held off by the ceiling run before the call returns.
+ * @param res Resource ID
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if it is not the
+ * last resource taken by the caller
+ */
+StatusType Os_ReleaseResource(ResourceType res);
+
+/**
+ * @brief Take a spinlock, busy-waiting while another core holds it
+ * @details Ticket lock: waiters get the lock in arrival order. A waiter that
+ * exhausts its spin budget sleeps until the lock is handed on, so a holder
+ * preempted on the same host CPU is not starved. The caller is not
+ * preempted by yield points while it holds a spinlock.
+ * @param lock Spinlock ID
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if the calling
+ * thread already holds it
+ */
+StatusType Os_GetSpinlock(SpinlockIdType lock);
+
+/**
+ * @brief Release a spinlock
+ * @param lock Spinlock ID
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if not held by the caller
+ */
+StatusType Os_ReleaseSpinlock(SpinlockIdType lock);
+
+/**
+ * @brief Take a spinlock only if it is free
+ * @param lock Spinlock ID
+ * @param success Set to TRYTOGETSPINLOCK_SUCCESS if the lock was taken
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if the calling
+ * thread already holds it
+ */
+StatusType Os_TryToGetSpinlock(SpinlockIdType lock, TryToGetSpinlockType* success);
+
+/**
+ * @brief Get the contention statistics of a spinlock
+ * @param lock Spinlock ID
+ * @param stats Pointer to store the statistics
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_GetSpinlockStats(SpinlockIdType lock, Os_SpinlockStatsType* stats);
+
+/* ============================================
+ * Inter-OS-Application Communicator (IOC)
+ * ============================================ */
+
+/**
+ * @brief Configure an IOC channel
+ * @details Empties the channel; no task may use it meanwhile. A queued
+ * channel has a single receiver. Use OS_IOC_DEFINE_QUEUED() or
+ * OS_IOC_DEFINE_UNQUEUED() for typed access.
+ * @param channel IOC channel ID
+ * @param config Semantics, element size and queue length
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_ConfigureIoc(IocChannelType channel, const Os_IocConfigType* config);
+
+/**
+ * @brief Append an element to a queued channel
+ * @details Lock-free: a ring buffer with one cache line per slot; a single
+ * sender only publishes its tail, several senders claim slots with a CAS.
+ * @param channel IOC channel ID
+ * @param data Element of the configured size
+ * @return IOC_E_OK, IOC_E_LIMIT if the queue is full, IOC_E_NOK on a bad argument
+ */
+Std_ReturnType Os_IocSend(IocChannelType channel, const void* data);
+
+/**
+ * @brief Take the oldest element of a queued channel
+ * @param channel IOC channel ID
+ * @param data Buffer of the configured size
+ * @return IOC_E_OK, IOC_E_LOST_DATA once after an overflow, IOC_E_NO_DATA
+ * if the queue is empty, IOC_E_NOK on a bad argument
+ */
+Std_ReturnType Os_IocReceive(IocChannelType channel, void* data);
+
+/**
+ * @brief Overwrite the value of a last-is-best channel
+ * @details Seqlock: readers never block the writer.
+ * @param channel IOC channel ID
+ * @param data Value of the configured size
+ * @return IOC_E_OK, IOC_E_NOK on a bad argument
+ */
+Std_ReturnType Os_IocWrite(IocChannelType channel, const void* data);
+
+/**
+ * @brief Read the value of a last-is-best channel
+ * @details Retries while a write is in progress, so the value is never
+ * torn. Reads zeros until the first write.
+ * @param channel IOC channel ID
+ * @param data Buffer of the configured size
+ * @return IOC_E_OK, IOC_E_NOK on a bad argument
+ */
+Std_ReturnType Os_IocRead(IocChannelType channel, void* data);
+
+/* ============================================
+ * Counters and Alarms
+ * ============================================ */
+
+/**
+ * @brief Configure an alarm
+ * @details The alarm must not be armed.
+ * @param alarm Alarm ID
+ * @param config Counter and expiry action
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_ConfigureAlarm(AlarmType alarm, const Os_AlarmConfigType* config);
+
+/**
+ * @brief Arm an alarm relative to the current counter value
+ * @details O(1) regardless of the number of armed alarms.
+ * @param alarm Alarm ID
+ * @param increment Ticks until the first expiry (> 0)
+ * @param cycle Period of a cyclic alarm, 0 for a single-shot alarm
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if already armed
+ */
+StatusType Os_SetRelAlarm(AlarmType alarm, TickType increment, TickType cycle);
+
+/**
+ * @brief Arm an alarm at an absolute counter value
+ * @details If start equals the current counter value the alarm expires
+ * immediately, before the call returns.
+ * @param alarm Alarm ID
+ * @param start Counter value of the first expiry
+ * @param cycle Period of a cyclic alarm, 0 for a single-shot alarm
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if already armed
+ */
+StatusType Os_SetAbsAlarm(AlarmType alarm, TickType start, TickType cycle);
+
+/**
+ * @brief Disarm an alarm
+ * @param alarm Alarm ID
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if not armed
+ */
+StatusType Os_CancelAlarm(AlarmType alarm);
+
+/**
+ * @brief Get the ticks left before an alarm expires
+ * @param alarm Alarm ID
+ * @param tick Pointer to store the remaining ticks
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if not armed
+ */
+StatusType Os_GetAlarm(AlarmType alarm, TickRefType tick);
+
+/**
+ * @brief Get the current value of a counter
+ * @param counter Counter ID
+ * @param value Pointer to store the counter value
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_GetCounterValue(CounterType counter, TickRefType value);
+
+/**
+ * @brief Advance a software counter by one tick
+ * @details Expires the alarms due on the new value. Not allowed on
+ * OS_COUNTER_SYSTEM, which is driven by the scheduler.
+ * @param counter Counter ID
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_IncrementCounter(CounterType counter);
+
+/* ============================================
+ * Schedule Tables
+ * ============================================ */
+
+/**
+ * @brief Configure a schedule table
+ * @details The table must be stopped. The configuration is referenced, not
+ * copied, so it must stay valid (typically a static const table).
+ * @param table Schedule table ID
+ * @param config Counter, duration and expiry points
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if the points are
+ * not sorted or an offset is not below the duration
+ */
+StatusType Os_ConfigureScheduleTable(ScheduleTableType table, const Os_ScheduleTableConfigType* config);
+
+/**
+ * @brief Start a schedule table relative to the current counter value
+ * @details The table starts 'offset' ticks from now; each expiry point is
+ * then processed at start + point offset.
+ * @param table Schedule table ID
+ * @param offset Ticks until the start of the table (> 0)
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if already running
+ */
+StatusType Os_StartScheduleTableRel(ScheduleTableType table, TickType offset);
+
+/**
+ * @brief Start a schedule table at an absolute counter value
+ * @param table Schedule table ID
+ * @param start Counter value at which the table starts
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if already running
+ */
+StatusType Os_StartScheduleTableAbs(ScheduleTableType table, TickType start);
+
+/**
+ * @brief Stop a schedule table
+ * @param table Schedule table ID
+ * @return OS_STATUS_OK if successful, OS_STATUS_ERROR if not running
+ */
+StatusType Os_StopScheduleTable(ScheduleTableType table);
+
+/**
+ * @brief Get the state of a schedule table
+ * @param table Schedule table ID
+ * @param status Pointer to store the state
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_GetScheduleTableStatus(ScheduleTableType table, ScheduleTableStatusRefType status);
+
 #endif /* OS_H */
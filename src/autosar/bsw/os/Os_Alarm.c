@@ -0,0 +1,421 @@
+/**
+ * @file Os_Alarm.c
+ * @brief AUTOSAR OS Abstraction Layer - Counters and Alarms
+ * @details Alarms are kept in one hierarchical timing wheel per counter:
+ * 6 levels of 64 slots cover the whole 32-bit TickType. Arming and
+ * cancelling are O(1); an alarm is moved down one level at most once per
+ * level before it expires, so expiry is amortized O(1) as well.
+ *
+ * Location: src/autosar/bsw/os/Os_Alarm.c
+ */
+
+#define _GNU_SOURCE
+
+#include "Os.h"
+#include "Os_Internal.h"
+#include <pthread.h>
+#include <stdio.h>
+
+/* Timing wheel geometry */
+#define WHEEL_BITS   6u
+#define WHEEL_SLOTS  (1u << WHEEL_BITS)
+#define WHEEL_MASK   (WHEEL_SLOTS - 1u)
+#define WHEEL_LEVELS 6u
+
+/* Alarm object, linked into one wheel slot while armed */
+typedef struct Os_AlarmNode {
+    struct Os_AlarmNode* next;
+    struct Os_AlarmNode** pprev;    /* NULL while the alarm is not armed */
+    TickType expiry;
+    TickType cycle;
+    uint8 level;
+    uint8 slot;
+    boolean configured;
+    Os_AlarmConfigType config;
+} Os_AlarmNode;
+
+/* Counter Control Block */
+typedef struct {
+    pthread_mutex_t lock;           /* Recursive: alarm actions may re-arm alarms */
+    TickType value;
+    uint32 armed;
+    uint64_t occupied[WHEEL_LEVELS]; /* One bit per non-empty slot */
+    Os_AlarmNode* slots[WHEEL_LEVELS][WHEEL_SLOTS];
+} CounterControlBlock;
+
+/* Application alarms first, then the ones reserved for the OS */
+#define ALARM_TOTAL (OS_ALARM_COUNT + OS_INTERNAL_ALARM_COUNT)
+
+static Os_AlarmNode alarms[ALARM_TOTAL];
+static CounterControlBlock counters[OS_COUNTER_COUNT];
+
+/* Link an alarm into the slot matching its distance from the counter value */
+static void wheel_insert(CounterControlBlock* ccb, Os_AlarmNode* node) {
+    TickType delta = node->expiry - ccb->value;
+    uint32 level = (delta == 0u) ? 0u : (uint32)(31 - __builtin_clz(delta)) / WHEEL_BITS;
+    uint32 slot = (node->expiry >> (level * WHEEL_BITS)) & WHEEL_MASK;
+    Os_AlarmNode** head = &ccb->slots[level][slot];
+
+    node->next = *head;
+    if (node->next != NULL) {
+        node->next->pprev = &node->next;
+    }
+    *head = node;
+    node->pprev = head;
+    node->level = (uint8)level;
+    node->slot = (uint8)slot;
+
+    ccb->occupied[level] |= (uint64_t)1u << slot;
+}
+
+/* Unlink an alarm from whatever list it is on */
+static void wheel_remove(CounterControlBlock* ccb, Os_AlarmNode* node) {
+    *node->pprev = node->next;
+    if (node->next != NULL) {
+        node->next->pprev = node->pprev;
+    }
+    node->next = NULL;
+    node->pprev = NULL;
+
+    if (ccb->slots[node->level][node->slot] == NULL) {
+        ccb->occupied[node->level] &= ~((uint64_t)1u << node->slot);
+    }
+}
+
+/* Detach a whole slot; the returned list head lives in the caller's frame */
+static void wheel_take_slot(CounterControlBlock* ccb, uint32 level, uint32 slot, Os_AlarmNode** list) {
+    *list = ccb->slots[level][slot];
+    ccb->slots[level][slot] = NULL;
+    ccb->occupied[level] &= ~((uint64_t)1u << slot);
+
+    if (*list != NULL) {
+        (*list)->pprev = list;
+    }
+}
+
+/* Run the expiry action of an alarm */
+static void alarm_action(AlarmType alarm) {
+    const Os_AlarmConfigType* config = &alarms[alarm].config;
+
+    switch (config->action) {
+        case OS_ALARM_ACTION_ACTIVATETASK:
+            Os_ActivateTask(config->task);
+            break;
+        case OS_ALARM_ACTION_SETEVENT:
+            Os_SetEvent(config->task, config->event);
+            break;
+        case OS_ALARM_ACTION_CALLBACK:
+            if (config->callback != NULL) {
+                config->callback(alarm);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/* Expire an alarm: re-arm it if cyclic, then run its action */
+static void alarm_expire(CounterControlBlock* ccb, Os_AlarmNode* node) {
+    if (node->cycle != 0u) {
+        node->expiry += node->cycle;
+        wheel_insert(ccb, node);
+    } else {
+        ccb->armed--;
+    }
+
+    alarm_action((AlarmType)(node - alarms));
+}
+
+/* Advance a counter by one tick */
+static void counter_tick(CounterControlBlock* ccb) {
+    Os_AlarmNode* list;
+    Os_AlarmNode* node;
+
+    ccb->value++;
+
+    /* Level 0 wrapped: move the next slot of each higher level down */
+    if ((ccb->value & WHEEL_MASK) == 0u) {
+        for (uint32 level = 1u; level < WHEEL_LEVELS; level++) {
+            uint32 slot = (ccb->value >> (level * WHEEL_BITS)) & WHEEL_MASK;
+
+            wheel_take_slot(ccb, level, slot, &list);
+            while ((node = list) != NULL) {
+                wheel_remove(ccb, node);
+                wheel_insert(ccb, node);
+            }
+
+            if (slot != 0u) {
+                break;
+            }
+        }
+    }
+
+    /* Expire the current level 0 slot; actions may cancel alarms still on the list */
+    wheel_take_slot(ccb, 0u, ccb->value & WHEEL_MASK, &list);
+    while ((node = list) != NULL) {
+        wheel_remove(ccb, node);
+        alarm_expire(ccb, node);
+    }
+}
+
+/* Common argument checks for the application alarm services */
+static Os_AlarmNode* get_alarm(AlarmType alarm) {
+    if (alarm >= OS_ALARM_COUNT || !alarms[alarm].configured) {
+        return NULL;
+    }
+    return &alarms[alarm];
+}
+
+/* Same for the alarms reserved for the OS */
+static Os_AlarmNode* get_internal_alarm(AlarmType alarm) {
+    if (alarm < OS_ALARM_COUNT || alarm >= ALARM_TOTAL || !alarms[alarm].configured) {
+        return NULL;
+    }
+    return &alarms[alarm];
+}
+
+void Os_AlarmInit(TickType system_now) {
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+
+    for (uint32 c = 0; c < OS_COUNTER_COUNT; c++) {
+        CounterControlBlock* ccb = &counters[c];
+
+        pthread_mutex_init(&ccb->lock, &attr);
+        ccb->value = (c == OS_COUNTER_SYSTEM) ? system_now : 0u;
+        ccb->armed = 0;
+        for (uint32 level = 0; level < WHEEL_LEVELS; level++) {
+            ccb->occupied[level] = 0;
+            for (uint32 slot = 0; slot < WHEEL_SLOTS; slot++) {
+                ccb->slots[level][slot] = NULL;
+            }
+        }
+    }
+    pthread_mutexattr_destroy(&attr);
+
+    for (uint32 a = 0; a < ALARM_TOTAL; a++) {
+        alarms[a].next = NULL;
+        alarms[a].pprev = NULL;
+        alarms[a].configured = FALSE;
+    }
+}
+
+void Os_CounterAdvance(CounterType counter, TickType now) {
+    CounterControlBlock* ccb = &counters[counter];
+
+    pthread_mutex_lock(&ccb->lock);
+    if (ccb->armed == 0u) {
+        /* Nothing to expire - jump straight to the new value */
+        if ((sint32)(now - ccb->value) > 0) {
+            ccb->value = now;
+        }
+    } else {
+        while ((sint32)(now - ccb->value) > 0) {
+            counter_tick(ccb);
+        }
+    }
+    pthread_mutex_unlock(&ccb->lock);
+}
+
+boolean Os_CounterNextExpiry(CounterType counter, TickType* tick) {
+    CounterControlBlock* ccb = &counters[counter];
+    boolean armed;
+
+    pthread_mutex_lock(&ccb->lock);
+    armed = (ccb->armed != 0u);
+    if (armed) {
+        uint32 index = ccb->value & WHEEL_MASK;
+        uint32 to_wrap = WHEEL_SLOTS - index;
+        uint32 shift = (index + 1u) & WHEEL_MASK;
+        uint64_t bits = ccb->occupied[0];
+        boolean upper = FALSE;
+
+        for (uint32 level = 1u; level < WHEEL_LEVELS; level++) {
+            upper = upper || (ccb->occupied[level] != 0u);
+        }
+
+        /* Rotate so that bit 0 is the slot of the next tick */
+        if (shift != 0u) {
+            bits = (bits >> shift) | (bits << (WHEEL_SLOTS - shift));
+        }
+
+        if (bits != 0u && ((uint32)__builtin_ctzll(bits) + 1u <= to_wrap || !upper)) {
+            *tick = ccb->value + (uint32)__builtin_ctzll(bits) + 1u;
+        } else {
+            /* Next cascade from the upper levels */
+            *tick = ccb->value + to_wrap;
+        }
+    }
+    pthread_mutex_unlock(&ccb->lock);
+
+    return armed;
+}
+
+void Os_CounterLock(CounterType counter) {
+    pthread_mutex_lock(&counters[counter].lock);
+}
+
+void Os_CounterUnlock(CounterType counter) {
+    pthread_mutex_unlock(&counters[counter].lock);
+}
+
+/* Store an alarm configuration; the alarm must be disarmed */
+static StatusType configure_alarm(AlarmType alarm, const Os_AlarmConfigType* config) {
+    if (config == NULL || config->counter >= OS_COUNTER_COUNT || alarms[alarm].pprev != NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    alarms[alarm].config = *config;
+    alarms[alarm].configured = TRUE;
+    return OS_STATUS_OK;
+}
+
+StatusType Os_ConfigureAlarm(AlarmType alarm, const Os_AlarmConfigType* config) {
+    if (alarm >= OS_ALARM_COUNT) {
+        return OS_STATUS_ERROR;
+    }
+    return configure_alarm(alarm, config);
+}
+
+StatusType Os_ConfigureInternalAlarm(AlarmType alarm, const Os_AlarmConfigType* config) {
+    if (alarm < OS_ALARM_COUNT || alarm >= ALARM_TOTAL) {
+        return OS_STATUS_ERROR;
+    }
+    return configure_alarm(alarm, config);
+}
+
+/* Arm an alarm at an absolute expiry value (counter lock held) */
+static StatusType arm_alarm(Os_AlarmNode* node, TickType expiry, TickType cycle) {
+    CounterControlBlock* ccb = &counters[node->config.counter];
+
+    if (node->pprev != NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    node->expiry = expiry;
+    node->cycle = cycle;
+    ccb->armed++;
+
+    if (expiry == ccb->value) {
+        alarm_expire(ccb, node);
+    } else {
+        wheel_insert(ccb, node);
+        if (node->config.counter == OS_COUNTER_SYSTEM) {
+            Os_SystemCounterArmed();
+        }
+    }
+    return OS_STATUS_OK;
+}
+
+StatusType Os_SetRelAlarm(AlarmType alarm, TickType increment, TickType cycle) {
+    Os_AlarmNode* node = get_alarm(alarm);
+    StatusType status;
+
+    if (node == NULL || increment == 0u) {
+        return OS_STATUS_ERROR;
+    }
+
+    CounterControlBlock* ccb = &counters[node->config.counter];
+    pthread_mutex_lock(&ccb->lock);
+    status = arm_alarm(node, ccb->value + increment, cycle);
+    pthread_mutex_unlock(&ccb->lock);
+
+    return status;
+}
+
+/* Arm at an absolute counter value, taking the counter lock */
+static StatusType set_abs_alarm(Os_AlarmNode* node, TickType start, TickType cycle) {
+    StatusType status;
+
+    if (node == NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    CounterControlBlock* ccb = &counters[node->config.counter];
+    pthread_mutex_lock(&ccb->lock);
+    status = arm_alarm(node, start, cycle);
+    pthread_mutex_unlock(&ccb->lock);
+
+    return status;
+}
+
+/* Disarm, taking the counter lock */
+static StatusType cancel_alarm(Os_AlarmNode* node) {
+    StatusType status = OS_STATUS_ERROR;
+
+    if (node == NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    CounterControlBlock* ccb = &counters[node->config.counter];
+    pthread_mutex_lock(&ccb->lock);
+    if (node->pprev != NULL) {
+        wheel_remove(ccb, node);
+        ccb->armed--;
+        status = OS_STATUS_OK;
+    }
+    pthread_mutex_unlock(&ccb->lock);
+
+    return status;
+}
+
+StatusType Os_SetAbsAlarm(AlarmType alarm, TickType start, TickType cycle) {
+    return set_abs_alarm(get_alarm(alarm), start, cycle);
+}
+
+StatusType Os_CancelAlarm(AlarmType alarm) {
+    return cancel_alarm(get_alarm(alarm));
+}
+
+StatusType Os_SetAbsInternalAlarm(AlarmType alarm, TickType start) {
+    return set_abs_alarm(get_internal_alarm(alarm), start, 0u);
+}
+
+StatusType Os_CancelInternalAlarm(AlarmType alarm) {
+    return cancel_alarm(get_internal_alarm(alarm));
+}
+
+StatusType Os_GetAlarm(AlarmType alarm, TickRefType tick) {
+    Os_AlarmNode* node = get_alarm(alarm);
+    StatusType status = OS_STATUS_ERROR;
+
+    if (node == NULL || tick == NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    CounterControlBlock* ccb = &counters[node->config.counter];
+    pthread_mutex_lock(&ccb->lock);
+    if (node->pprev != NULL) {
+        *tick = node->expiry - ccb->value;
+        status = OS_STATUS_OK;
+    }
+    pthread_mutex_unlock(&ccb->lock);
+
+    return status;
+}
+
+StatusType Os_GetCounterValue(CounterType counter, TickRefType value) {
+    if (counter >= OS_COUNTER_COUNT || value == NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    pthread_mutex_lock(&counters[counter].lock);
+    *value = counters[counter].value;
+    pthread_mutex_unlock(&counters[counter].lock);
+
+    return OS_STATUS_OK;
+}
+
+StatusType Os_IncrementCounter(CounterType counter) {
+    if (counter >= OS_COUNTER_COUNT || counter == OS_COUNTER_SYSTEM) {
+        return OS_STATUS_ERROR;
+    }
+
+    pthread_mutex_lock(&counters[counter].lock);
+    counter_tick(&counters[counter]);
+    pthread_mutex_unlock(&counters[counter].lock);
+
+    return OS_STATUS_OK;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file Os_Coroutine.c
+ * @brief AUTOSAR OS Abstraction Layer - Stackful coroutine runnables
+ * @details A coroutine runnable runs on a stack of its own, switched to
+ * with swapcontext() on the thread of its task. Os_Yield() switches back to
+ * the task, which carries on with its next runnable; the next activation
+ * switches into the coroutine again where it left off.
+ *
+ * Stacks are static, one per slot, so registering a coroutine never
+ * allocates.
+ *
+ * Location: src/autosar/bsw/os/Os_Coroutine.c
+ */
+
+#define _GNU_SOURCE
+
+#include "Os.h"
+#include "Os_Internal.h"
+#include <stdio.h>
+#include <ucontext.h>
+
+/* Coroutine Control Block */
+typedef struct {
+    ucontext_t context;             /* Where the coroutine continues */
+    ucontext_t caller;              /* Where Os_Yield() or the return goes back to */
+    TaskFunc func;
+    boolean running;                /* Started and not returned yet */
+    _Alignas(16) uint8 stack[OS_COROUTINE_STACK_SIZE];
+} CoroutineControlBlock;
+
+static CoroutineControlBlock coroutines[OS_COROUTINE_COUNT];
+static uint32 coroutine_count = 0;
+
+/* Coroutine running on this thread; an activation nested in it saves it */
+static _Thread_local CoroutineControlBlock* current_coroutine = NULL;
+
+/* First entry of every coroutine; returning ends in cocb->caller (uc_link) */
+static void coroutine_entry(void) {
+    CoroutineControlBlock* cocb = current_coroutine;
+
+    cocb->func();
+    cocb->running = FALSE;
+}
+
+void Os_CoroutineInit(void) {
+    for (uint32 c = 0; c < OS_COROUTINE_COUNT; c++) {
+        coroutines[c].func = NULL;
+        coroutines[c].running = FALSE;
+    }
+    coroutine_count = 0;
+}
+
+uint32 Os_CoroutineCreate(TaskFunc func) {
+    if (coroutine_count >= OS_COROUTINE_COUNT) {
+        return OS_COROUTINE_COUNT;
+    }
+
+    coroutines[coroutine_count].func = func;
+    coroutines[coroutine_count].running = FALSE;
+    return coroutine_count++;
+}
+
+void Os_RunnableExecute(const Os_RunnableType* runnable) {
+    CoroutineControlBlock* outer = current_coroutine;
+
+    /* Os_Yield() applies to the runnable it is called from, not to an outer one */
+    if (runnable->coroutine >= OS_COROUTINE_COUNT) {
+        current_coroutine = NULL;
+        runnable->func();
+        current_coroutine = outer;
+        return;
+    }
+
+    CoroutineControlBlock* cocb = &coroutines[runnable->coroutine];
+
+    if (!cocb->running) {
+        /* Start over on a fresh stack */
+        getcontext(&cocb->context);
+        cocb->context.uc_stack.ss_sp = cocb->stack;
+        cocb->context.uc_stack.ss_size = sizeof(cocb->stack);
+        cocb->context.uc_link = &cocb->caller;
+        makecontext(&cocb->context, coroutine_entry, 0);
+        cocb->running = TRUE;
+    }
+
+    current_coroutine = cocb;
+    swapcontext(&cocb->caller, &cocb->context);
+    current_coroutine = outer;
+}
+
+StatusType Os_Yield(void) {
+    CoroutineControlBlock* cocb = current_coroutine;
+
+    if (cocb == NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    swapcontext(&cocb->context, &cocb->caller);
+
+    /* Resumed by the next activation, possibly inside another nesting */
+    return OS_STATUS_OK;
+}
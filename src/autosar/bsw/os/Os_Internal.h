@@ -0,0 +1,163 @@
+/**
+ * @file Os_Internal.h
+ * @brief AUTOSAR OS Abstraction Layer - Internal interfaces
+ * @details Functions shared between the OS translation units only.
+ * Application code must use Os.h.
+ *
+ * Location: src/autosar/bsw/os/Os_Internal.h
+ */
+
+#ifndef OS_INTERNAL_H
+#define OS_INTERNAL_H
+
+#include "Os.h"
+
+/* Host cache line size, used to keep hot words of different owners apart */
+#define OS_CACHE_LINE_SIZE 64u
+
+/* Alarm objects reserved for the OS, numbered after the application alarms */
+#define OS_INTERNAL_ALARM_COUNT OS_SCHEDULETABLE_COUNT
+#define OS_SCHEDULETABLE_ALARM(table) ((AlarmType)(OS_ALARM_COUNT + (table)))
+
+/**
+ * @brief Reset all counters and alarms
+ * @param system_now Initial value of OS_COUNTER_SYSTEM
+ */
+void Os_AlarmInit(TickType system_now);
+
+/**
+ * @brief Advance a counter up to 'now', expiring every alarm on the way
+ * @param counter Counter to advance
+ * @param now Target counter value
+ */
+void Os_CounterAdvance(CounterType counter, TickType now);
+
+/**
+ * @brief Earliest counter value at which Os_CounterAdvance() has work to do
+ * @details Conservative: may return a wheel cascade point with no expiry.
+ * @param counter Counter to query
+ * @param tick Pointer to store the counter value
+ * @return TRUE if an alarm is armed on the counter, FALSE otherwise
+ */
+boolean Os_CounterNextExpiry(CounterType counter, TickType* tick);
+
+/**
+ * @brief Tell the core driving OS_COUNTER_SYSTEM that a new expiry was armed
+ * @details Lets the master core shorten its sleep if the expiry is earlier
+ * than its next planned wake-up.
+ */
+void Os_SystemCounterArmed(void);
+
+/**
+ * @brief Take / release the (recursive) lock of a counter
+ * @details Alarm callbacks already run with the lock of their counter held.
+ */
+void Os_CounterLock(CounterType counter);
+void Os_CounterUnlock(CounterType counter);
+
+/**
+ * @brief Configure an OS-internal alarm (OS_SCHEDULETABLE_ALARM(), ...)
+ * @param alarm Internal alarm ID
+ * @param config Counter and expiry action
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_ConfigureInternalAlarm(AlarmType alarm, const Os_AlarmConfigType* config);
+
+/**
+ * @brief Arm an OS-internal single-shot alarm at an absolute counter value
+ * @param alarm Internal alarm ID
+ * @param start Counter value of the expiry (expires at once if current)
+ * @return OS_STATUS_OK if successful
+ */
+StatusType Os_SetAbsInternalAlarm(AlarmType alarm, TickType start);
+
+/**
+ * @brief Disarm an OS-internal alarm
+ * @param alarm Internal alarm ID
+ * @return OS_STATUS_OK if it was armed
+ */
+StatusType Os_CancelInternalAlarm(AlarmType alarm);
+
+/**
+ * @brief Stop all schedule tables and forget their configuration
+ */
+void Os_ScheduleTableInit(void);
+
+/**
+ * @brief Release every spinlock and reset the contention statistics
+ */
+void Os_SpinlockInit(void);
+
+/**
+ * @brief Whether the calling thread holds a spinlock
+ * @details Yield points do not preempt a spinlock holder.
+ */
+boolean Os_SpinlockHeld(void);
+
+/**
+ * @brief Log the contention statistics of every spinlock that was used
+ */
+void Os_PrintSpinlockStats(void);
+
+/**
+ * @brief Mark every IOC channel as not configured
+ */
+void Os_IocInit(void);
+
+/**
+ * @brief Empty the job queues
+ */
+void Os_JobPoolInit(void);
+
+/**
+ * @brief Start the job pool threads
+ */
+void Os_JobPoolStart(void);
+
+/**
+ * @brief Let the job pool finish every queued job, then join its threads
+ */
+void Os_JobPoolStop(void);
+
+/**
+ * @brief Release every coroutine slot
+ */
+void Os_CoroutineInit(void);
+
+/**
+ * @brief Take a coroutine slot for a runnable function
+ * @param func Runnable function pointer
+ * @return Slot index, OS_COROUTINE_COUNT if none is left
+ */
+uint32 Os_CoroutineCreate(TaskFunc func);
+
+/**
+ * @brief Execute one runnable of the running task
+ * @details Calls a plain runnable; starts or resumes a coroutine runnable
+ * until it yields or returns.
+ * @param runnable Runnable entry
+ */
+void Os_RunnableExecute(const Os_RunnableType* runnable);
+
+/**
+ * @brief Clear the trace buffers and stop recording
+ */
+void Os_TraceInit(void);
+
+/**
+ * @brief Record a trace event of the OS
+ * @param event Event type
+ * @param task Task the event belongs to
+ * @param id Object the event is about
+ * @param value Event argument
+ * @param name Static name of the object, NULL to name it after the event
+ */
+void Os_TraceRecord(Os_TraceEventType event, TaskType task, uint32 id, uint32 value,
+                    const char* name);
+
+/**
+ * @brief Task running on the calling thread, TASK_IDLE outside every task
+ */
+TaskType Os_GetCurrentTask(void);
+
+#endif /* OS_INTERNAL_H */
@@ -0,0 +1,227 @@
+/**
+ * @file Os_Ioc.c
+ * @brief AUTOSAR OS Abstraction Layer - Inter-OS-Application Communicator
+ * @details Lock-free channels for data crossing cores:
+ *   - queued:   bounded ring buffer; a single sender publishes its tail with
+ *               a release store, several senders claim slots with a CAS on
+ *               the tail and publish each slot through its sequence word
+ *   - unqueued: last-is-best value behind a seqlock
+ *
+ * The sender and receiver indices live on their own cache lines, and every
+ * queue slot fills one cache line, so the two sides only share the lines of
+ * the elements they hand over.
+ *
+ * Location: src/autosar/bsw/os/Os_Ioc.c
+ */
+
+#include "Os.h"
+#include "Os_Internal.h"
+#include <stdatomic.h>
+#include <string.h>
+
+_Static_assert((OS_IOC_MAX_QUEUE_LENGTH & (OS_IOC_MAX_QUEUE_LENGTH - 1u)) == 0u,
+               "OS_IOC_MAX_QUEUE_LENGTH must be a power of two");
+
+/* One element with its sequence word (multi-sender queues only) */
+typedef struct {
+    _Alignas(OS_CACHE_LINE_SIZE) _Atomic uint32 sequence;
+    uint8 data[OS_IOC_MAX_DATA_SIZE];
+} IocSlotType;
+
+/* IOC Channel Control Block */
+typedef struct {
+    _Alignas(OS_CACHE_LINE_SIZE) _Atomic uint32 tail;  /* Next slot to fill, written by senders */
+    _Atomic uint32 seqlock;         /* Unqueued: odd while a write is in progress */
+    _Alignas(OS_CACHE_LINE_SIZE) _Atomic uint32 head;  /* Next slot to drain, written by the receiver */
+    _Atomic boolean lost;           /* An element was dropped since the last receive */
+    _Alignas(OS_CACHE_LINE_SIZE) Os_IocConfigType config;
+    boolean configured;
+    IocSlotType slots[OS_IOC_MAX_QUEUE_LENGTH];
+} IocChannelControlBlock;
+
+static IocChannelControlBlock channels[OS_IOC_COUNT];
+
+/* Common argument checks for the IOC services */
+static IocChannelControlBlock* get_channel(IocChannelType channel, Os_IocSemanticsType semantics,
+                                           const void* data) {
+    if (channel >= OS_IOC_COUNT || data == NULL || !channels[channel].configured ||
+        channels[channel].config.semantics != semantics) {
+        return NULL;
+    }
+    return &channels[channel];
+}
+
+void Os_IocInit(void) {
+    for (uint32 c = 0; c < OS_IOC_COUNT; c++) {
+        channels[c].configured = FALSE;
+    }
+}
+
+StatusType Os_ConfigureIoc(IocChannelType channel, const Os_IocConfigType* config) {
+    IocChannelControlBlock* iccb;
+
+    if (channel >= OS_IOC_COUNT || config == NULL ||
+        config->data_size == 0u || config->data_size > OS_IOC_MAX_DATA_SIZE) {
+        return OS_STATUS_ERROR;
+    }
+    if (config->semantics == OS_IOC_QUEUED &&
+        (config->queue_length == 0u || config->queue_length > OS_IOC_MAX_QUEUE_LENGTH ||
+         (config->queue_length & (config->queue_length - 1u)) != 0u)) {
+        return OS_STATUS_ERROR;
+    }
+
+    iccb = &channels[channel];
+    iccb->config = *config;
+    atomic_store(&iccb->tail, 0u);
+    atomic_store(&iccb->head, 0u);
+    atomic_store(&iccb->lost, FALSE);
+    atomic_store(&iccb->seqlock, 0u);
+    for (uint32 i = 0; i < OS_IOC_MAX_QUEUE_LENGTH; i++) {
+        atomic_store(&iccb->slots[i].sequence, i);
+        memset(iccb->slots[i].data, 0, sizeof(iccb->slots[i].data));
+    }
+    iccb->configured = TRUE;
+
+    return OS_STATUS_OK;
+}
+
+/* Single sender: the receiver sees the element once the tail moves past it */
+static Std_ReturnType send_single(IocChannelControlBlock* iccb, const void* data) {
+    uint32 tail = atomic_load_explicit(&iccb->tail, memory_order_relaxed);
+    uint32 head = atomic_load_explicit(&iccb->head, memory_order_acquire);
+
+    if (tail - head >= iccb->config.queue_length) {
+        return IOC_E_LIMIT;
+    }
+
+    memcpy(iccb->slots[tail & (iccb->config.queue_length - 1u)].data, data, iccb->config.data_size);
+    atomic_store_explicit(&iccb->tail, tail + 1u, memory_order_release);
+
+    return IOC_E_OK;
+}
+
+/* Several senders: claim a slot on the tail, publish it through its sequence */
+static Std_ReturnType send_multi(IocChannelControlBlock* iccb, const void* data) {
+    const uint32 length = iccb->config.queue_length;
+    uint32 tail = atomic_load_explicit(&iccb->tail, memory_order_relaxed);
+    IocSlotType* slot;
+
+    for (;;) {
+        slot = &iccb->slots[tail & (length - 1u)];
+        uint32 sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        sint32 diff = (sint32)(sequence - tail);
+
+        if (diff == 0) {
+            /* Slot free for this lap - claim it (tail is reloaded on failure) */
+            if (atomic_compare_exchange_weak_explicit(&iccb->tail, &tail, tail + 1u,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* Slot still holds the element of the previous lap */
+            return IOC_E_LIMIT;
+        } else {
+            tail = atomic_load_explicit(&iccb->tail, memory_order_relaxed);
+        }
+    }
+
+    memcpy(slot->data, data, iccb->config.data_size);
+    atomic_store_explicit(&slot->sequence, tail + 1u, memory_order_release);
+
+    return IOC_E_OK;
+}
+
+Std_ReturnType Os_IocSend(IocChannelType channel, const void* data) {
+    IocChannelControlBlock* iccb = get_channel(channel, OS_IOC_QUEUED, data);
+    Std_ReturnType result;
+
+    if (iccb == NULL) {
+        return IOC_E_NOK;
+    }
+
+    result = iccb->config.multi_sender ? send_multi(iccb, data) : send_single(iccb, data);
+    if (result == IOC_E_LIMIT) {
+        atomic_store_explicit(&iccb->lost, TRUE, memory_order_relaxed);
+    }
+
+    return result;
+}
+
+Std_ReturnType Os_IocReceive(IocChannelType channel, void* data) {
+    IocChannelControlBlock* iccb = get_channel(channel, OS_IOC_QUEUED, data);
+
+    if (iccb == NULL) {
+        return IOC_E_NOK;
+    }
+
+    const uint32 length = iccb->config.queue_length;
+    uint32 head = atomic_load_explicit(&iccb->head, memory_order_relaxed);
+    IocSlotType* slot = &iccb->slots[head & (length - 1u)];
+
+    if (iccb->config.multi_sender) {
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != head + 1u) {
+            return IOC_E_NO_DATA;
+        }
+        memcpy(data, slot->data, iccb->config.data_size);
+
+        /* Hand the slot to the sender of the next lap */
+        atomic_store_explicit(&slot->sequence, head + length, memory_order_release);
+    } else {
+        if (atomic_load_explicit(&iccb->tail, memory_order_acquire) == head) {
+            return IOC_E_NO_DATA;
+        }
+        memcpy(data, slot->data, iccb->config.data_size);
+    }
+    atomic_store_explicit(&iccb->head, head + 1u, memory_order_release);
+
+    if (atomic_exchange_explicit(&iccb->lost, FALSE, memory_order_relaxed)) {
+        return IOC_E_LOST_DATA;
+    }
+    return IOC_E_OK;
+}
+
+Std_ReturnType Os_IocWrite(IocChannelType channel, const void* data) {
+    IocChannelControlBlock* iccb = get_channel(channel, OS_IOC_UNQUEUED, data);
+    uint32 sequence;
+
+    if (iccb == NULL) {
+        return IOC_E_NOK;
+    }
+
+    /* Make the sequence odd; concurrent writers wait for the even value */
+    sequence = atomic_load_explicit(&iccb->seqlock, memory_order_relaxed);
+    for (;;) {
+        if ((sequence & 1u) == 0u &&
+            atomic_compare_exchange_weak_explicit(&iccb->seqlock, &sequence, sequence + 1u,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+        sequence = atomic_load_explicit(&iccb->seqlock, memory_order_relaxed);
+    }
+    atomic_thread_fence(memory_order_release);
+
+    memcpy(iccb->slots[0].data, data, iccb->config.data_size);
+    atomic_store_explicit(&iccb->seqlock, sequence + 2u, memory_order_release);
+
+    return IOC_E_OK;
+}
+
+Std_ReturnType Os_IocRead(IocChannelType channel, void* data) {
+    IocChannelControlBlock* iccb = get_channel(channel, OS_IOC_UNQUEUED, data);
+    uint32 before;
+    uint32 after;
+
+    if (iccb == NULL) {
+        return IOC_E_NOK;
+    }
+
+    /* Retry until no write overlapped the copy */
+    do {
+        before = atomic_load_explicit(&iccb->seqlock, memory_order_acquire);
+        memcpy(data, iccb->slots[0].data, iccb->config.data_size);
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&iccb->seqlock, memory_order_relaxed);
+    } while ((before & 1u) != 0u || before != after);
+
+    return IOC_E_OK;
+}
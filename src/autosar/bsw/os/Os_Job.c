@@ -0,0 +1,322 @@
+/**
+ * @file Os_Job.c
+ * @brief AUTOSAR OS Abstraction Layer - Background job pool
+ * @details Work-stealing pool for non-periodic work (log formatting, trace
+ * compression, NvM flushing) that must not run inside a task.
+ *
+ * Each pool thread owns a Chase-Lev deque: it pushes and takes jobs at the
+ * bottom without atomic read-modify-writes, idle threads steal from the
+ * top with one CAS. Tasks are not pool threads, so their jobs go to a
+ * bounded multi-producer / multi-consumer injection queue first.
+ *
+ * Location: src/autosar/bsw/os/Os_Job.c
+ */
+
+#define _GNU_SOURCE
+
+#include "Os.h"
+#include "Os_Internal.h"
+#include <limits.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+_Static_assert((OS_JOB_QUEUE_LENGTH & (OS_JOB_QUEUE_LENGTH - 1u)) == 0u,
+               "OS_JOB_QUEUE_LENGTH must be a power of two");
+
+#define OS_JOB_INDEX_MASK ((int64_t)OS_JOB_QUEUE_LENGTH - 1)
+
+typedef struct {
+    Os_JobFuncType func;
+    Os_JobFuncType done;
+    void* arg;
+} Os_JobType;
+
+/* Chase-Lev deque of one pool thread */
+typedef struct {
+    _Alignas(OS_CACHE_LINE_SIZE) _Atomic int64_t top;      /* Thieves take here */
+    _Alignas(OS_CACHE_LINE_SIZE) _Atomic int64_t bottom;   /* The owner pushes and takes here */
+    Os_JobType jobs[OS_JOB_QUEUE_LENGTH];
+} Os_JobDequeType;
+
+/* Injection queue slot; the sequence tells whose turn the slot is */
+typedef struct {
+    _Atomic uint32 sequence;
+    Os_JobType job;
+} Os_JobSlotType;
+
+typedef struct {
+    _Alignas(OS_CACHE_LINE_SIZE) _Atomic uint32 tail;
+    _Alignas(OS_CACHE_LINE_SIZE) _Atomic uint32 head;
+    _Alignas(OS_CACHE_LINE_SIZE) Os_JobSlotType slots[OS_JOB_QUEUE_LENGTH];
+} Os_JobQueueType;
+
+static Os_JobDequeType deques[OS_JOB_WORKER_COUNT];
+static Os_JobQueueType injection;
+static pthread_t workers[OS_JOB_WORKER_COUNT];
+static uint32 started_workers = 0;
+static atomic_bool pool_stop = false;
+
+/* Futex generation the idle pool threads sleep on */
+static _Alignas(OS_CACHE_LINE_SIZE) _Atomic uint32 pool_wakeup = 0;
+static _Atomic uint32 pool_sleepers = 0;
+
+/* Statistics, printed when the pool stops */
+static _Atomic uint32 jobs_run = 0;
+static _Atomic uint32 jobs_stolen = 0;
+
+/* Index of the pool thread running the caller, OS_JOB_WORKER_COUNT outside the pool */
+static _Thread_local uint32 worker_index = OS_JOB_WORKER_COUNT;
+
+/* Owner only: push at the bottom */
+static boolean deque_push(Os_JobDequeType* deque, const Os_JobType* job) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+
+    if (bottom - top >= (int64_t)OS_JOB_QUEUE_LENGTH) {
+        return FALSE;
+    }
+
+    deque->jobs[bottom & OS_JOB_INDEX_MASK] = *job;
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return TRUE;
+}
+
+/* Owner only: take the newest job; races the thieves only for the last one */
+static boolean deque_take(Os_JobDequeType* deque, Os_JobType* job) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    int64_t top;
+    boolean taken = TRUE;
+
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (top > bottom) {
+        /* Empty */
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return FALSE;
+    }
+
+    *job = deque->jobs[bottom & OS_JOB_INDEX_MASK];
+    if (top == bottom) {
+        taken = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                        memory_order_seq_cst, memory_order_relaxed);
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+    return taken;
+}
+
+/* Any thread: take the oldest job */
+static boolean deque_steal(Os_JobDequeType* deque, Os_JobType* job) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (top >= bottom) {
+        return FALSE;
+    }
+
+    /* The slot cannot be reused before top moves past it */
+    *job = deque->jobs[top & OS_JOB_INDEX_MASK];
+    return atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                   memory_order_seq_cst, memory_order_relaxed);
+}
+
+/* Any thread: append to the injection queue */
+static boolean injection_push(const Os_JobType* job) {
+    uint32 tail = atomic_load_explicit(&injection.tail, memory_order_relaxed);
+    Os_JobSlotType* slot;
+
+    for (;;) {
+        slot = &injection.slots[tail & (OS_JOB_QUEUE_LENGTH - 1u)];
+        sint32 diff = (sint32)(atomic_load_explicit(&slot->sequence, memory_order_acquire) - tail);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&injection.tail, &tail, tail + 1u,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return FALSE;
+        } else {
+            tail = atomic_load_explicit(&injection.tail, memory_order_relaxed);
+        }
+    }
+
+    slot->job = *job;
+    atomic_store_explicit(&slot->sequence, tail + 1u, memory_order_release);
+    return TRUE;
+}
+
+/* Pool threads: take the oldest job of the injection queue */
+static boolean injection_pop(Os_JobType* job) {
+    uint32 head = atomic_load_explicit(&injection.head, memory_order_relaxed);
+    Os_JobSlotType* slot;
+
+    for (;;) {
+        slot = &injection.slots[head & (OS_JOB_QUEUE_LENGTH - 1u)];
+        sint32 diff = (sint32)(atomic_load_explicit(&slot->sequence, memory_order_acquire) - (head + 1u));
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&injection.head, &head, head + 1u,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return FALSE;
+        } else {
+            head = atomic_load_explicit(&injection.head, memory_order_relaxed);
+        }
+    }
+
+    *job = slot->job;
+    atomic_store_explicit(&slot->sequence, head + OS_JOB_QUEUE_LENGTH, memory_order_release);
+    return TRUE;
+}
+
+/* Wake the idle pool threads (skips the syscall if none sleeps) */
+static void wake_pool(void) {
+    atomic_fetch_add(&pool_wakeup, 1u);
+    if (atomic_load(&pool_sleepers) != 0u) {
+        syscall(SYS_futex, (uint32*)&pool_wakeup, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+/* Own deque first, then the tasks' jobs, then steal from the other threads */
+static boolean find_job(uint32 self, Os_JobType* job) {
+    if (deque_take(&deques[self], job) || injection_pop(job)) {
+        return TRUE;
+    }
+
+    for (uint32 k = 1; k < OS_JOB_WORKER_COUNT; k++) {
+        if (deque_steal(&deques[(self + k) % OS_JOB_WORKER_COUNT], job)) {
+            atomic_fetch_add_explicit(&jobs_stolen, 1u, memory_order_relaxed);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static void* worker_main(void* arg) {
+    Os_JobType job;
+
+    worker_index = (uint32)(uintptr_t)arg;
+
+    for (;;) {
+        /* Snapshot the generation before looking for work, pairs with wake_pool() */
+        uint32 generation = atomic_load(&pool_wakeup);
+
+        if (find_job(worker_index, &job)) {
+            job.func(job.arg);
+            if (job.done != NULL) {
+                job.done(job.arg);
+            }
+            atomic_fetch_add_explicit(&jobs_run, 1u, memory_order_relaxed);
+            continue;
+        }
+
+        /* Nothing left anywhere: the other threads drain their own deques */
+        if (atomic_load(&pool_stop)) {
+            break;
+        }
+
+        atomic_fetch_add(&pool_sleepers, 1u);
+        if (atomic_load(&pool_wakeup) == generation) {
+            syscall(SYS_futex, (uint32*)&pool_wakeup, FUTEX_WAIT_PRIVATE, generation, NULL, NULL, 0);
+        }
+        atomic_fetch_sub(&pool_sleepers, 1u);
+    }
+
+    return NULL;
+}
+
+void Os_JobPoolInit(void) {
+    for (uint32 w = 0; w < OS_JOB_WORKER_COUNT; w++) {
+        atomic_store(&deques[w].top, 0);
+        atomic_store(&deques[w].bottom, 0);
+    }
+    atomic_store(&injection.tail, 0u);
+    atomic_store(&injection.head, 0u);
+    for (uint32 i = 0; i < OS_JOB_QUEUE_LENGTH; i++) {
+        atomic_store(&injection.slots[i].sequence, i);
+    }
+    atomic_store(&jobs_run, 0u);
+    atomic_store(&jobs_stolen, 0u);
+}
+
+StatusType Os_SubmitJob(Os_JobFuncType func, void* arg, Os_JobFuncType done) {
+    const Os_JobType job = { func, done, arg };
+
+    if (func == NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    /* A job spawning jobs keeps them local; others go through the injection queue */
+    if (!(worker_index < OS_JOB_WORKER_COUNT && deque_push(&deques[worker_index], &job)) &&
+        !injection_push(&job)) {
+        return OS_STATUS_ERROR;
+    }
+
+    wake_pool();
+    return OS_STATUS_OK;
+}
+
+void Os_JobPoolStart(void) {
+    long host_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32 spare_cpus = (host_cpus > (long)OS_CORE_COUNT) ? (uint32)host_cpus - OS_CORE_COUNT : 0u;
+
+    atomic_store(&pool_stop, false);
+    started_workers = 0;
+
+    for (uint32 w = 0; w < OS_JOB_WORKER_COUNT; w++) {
+        pthread_attr_t attr;
+        struct sched_param param = { .sched_priority = 0 };
+        cpu_set_t set;
+
+        pthread_attr_init(&attr);
+        if (spare_cpus > 0u) {
+            /* Host CPUs after the ones backing the emulated cores */
+            CPU_ZERO(&set);
+            CPU_SET((int)(OS_CORE_COUNT + w % spare_cpus), &set);
+            pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+        } else {
+            /* Sharing CPUs with the cores: run only when they are idle */
+            pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+            pthread_attr_setschedpolicy(&attr, SCHED_IDLE);
+            pthread_attr_setschedparam(&attr, &param);
+        }
+
+        if (pthread_create(&workers[w], &attr, worker_main, (void*)(uintptr_t)w) != 0) {
+            /* Thread w's deque is only filled by thread w, the others still cover everything */
+            printf("[OS] ERROR: Failed to start job pool thread %u\n", w);
+            pthread_attr_destroy(&attr);
+            break;
+        }
+        pthread_attr_destroy(&attr);
+        started_workers++;
+    }
+
+    printf("[OS] Job pool: %u thread(s) %s\n", started_workers,
+           (spare_cpus > 0u) ? "on spare host CPUs" : "at SCHED_IDLE");
+}
+
+void Os_JobPoolStop(void) {
+    atomic_store(&pool_stop, true);
+    wake_pool();
+    for (uint32 w = 0; w < started_workers; w++) {
+        pthread_join(workers[w], NULL);
+    }
+    started_workers = 0;
+
+    if (atomic_load(&jobs_run) > 0u) {
+        printf("[OS] Job pool: %u job(s) run, %u stolen\n",
+               atomic_load(&jobs_run), atomic_load(&jobs_stolen));
+    }
+}
@@ -0,0 +1,183 @@
+/**
+ * @file Os_ScheduleTable.c
+ * @brief AUTOSAR OS Abstraction Layer - Schedule Tables
+ * @details A schedule table is a static list of expiry points, each at an
+ * offset from the start of the table. Only the next expiry point of a
+ * running table is armed, on an OS-internal alarm of the table's counter,
+ * so tables share the timing wheel with the application alarms.
+ *
+ * Giving tasks of the same period different offsets spreads their
+ * activations over the hyperperiod instead of stacking them on one tick.
+ *
+ * Location: src/autosar/bsw/os/Os_ScheduleTable.c
+ */
+
+#include "Os.h"
+#include "Os_Internal.h"
+#include <stdio.h>
+
+/* Schedule Table Control Block */
+typedef struct {
+    const Os_ScheduleTableConfigType* config;
+    ScheduleTableStatusType status;
+    TickType start;                 /* Counter value of offset 0 of the current round */
+    uint32 next_point;              /* Index of the next expiry point to process */
+} ScheduleTableControlBlock;
+
+static ScheduleTableControlBlock tables[OS_SCHEDULETABLE_COUNT];
+
+/* Arm the internal alarm for the next expiry point */
+static void arm_next_point(ScheduleTableType table) {
+    ScheduleTableControlBlock* stcb = &tables[table];
+
+    Os_SetAbsInternalAlarm(OS_SCHEDULETABLE_ALARM(table),
+                           stcb->start + stcb->config->points[stcb->next_point].offset);
+}
+
+/* Internal alarm callback: process every action of the expiry point due now */
+static void expiry_point_reached(AlarmType alarm) {
+    ScheduleTableType table = alarm - OS_SCHEDULETABLE_ALARM(0);
+    ScheduleTableControlBlock* stcb = &tables[table];
+    const Os_ScheduleTableConfigType* config = stcb->config;
+    TickType offset = config->points[stcb->next_point].offset;
+
+    while (stcb->next_point < config->point_count &&
+           config->points[stcb->next_point].offset == offset) {
+        const Os_ExpiryPointType* point = &config->points[stcb->next_point];
+
+        if (point->event == 0u) {
+            Os_ActivateTask(point->task);
+        } else {
+            Os_SetEvent(point->task, point->event);
+        }
+        stcb->next_point++;
+    }
+
+    if (stcb->next_point < config->point_count) {
+        arm_next_point(table);
+    } else if (config->repeating) {
+        stcb->start += config->duration;
+        stcb->next_point = 0;
+        arm_next_point(table);
+    } else {
+        stcb->status = SCHEDULETABLE_STOPPED;
+    }
+}
+
+/* Common argument checks for the schedule table services */
+static ScheduleTableControlBlock* get_table(ScheduleTableType table) {
+    if (table >= OS_SCHEDULETABLE_COUNT || tables[table].config == NULL) {
+        return NULL;
+    }
+    return &tables[table];
+}
+
+/* Start a stopped table whose first round begins at 'start' */
+static StatusType start_table(ScheduleTableType table, TickType start) {
+    ScheduleTableControlBlock* stcb = &tables[table];
+    CounterType counter = stcb->config->counter;
+    StatusType status = OS_STATUS_ERROR;
+
+    Os_CounterLock(counter);
+    if (stcb->status == SCHEDULETABLE_STOPPED) {
+        stcb->status = SCHEDULETABLE_RUNNING;
+        stcb->start = start;
+        stcb->next_point = 0;
+        arm_next_point(table);
+        status = OS_STATUS_OK;
+    }
+    Os_CounterUnlock(counter);
+
+    return status;
+}
+
+void Os_ScheduleTableInit(void) {
+    for (uint32 t = 0; t < OS_SCHEDULETABLE_COUNT; t++) {
+        tables[t].config = NULL;
+        tables[t].status = SCHEDULETABLE_STOPPED;
+        tables[t].start = 0;
+        tables[t].next_point = 0;
+    }
+}
+
+StatusType Os_ConfigureScheduleTable(ScheduleTableType table, const Os_ScheduleTableConfigType* config) {
+    Os_AlarmConfigType alarm_config;
+
+    if (table >= OS_SCHEDULETABLE_COUNT || config == NULL || config->points == NULL ||
+        config->point_count == 0u || config->duration == 0u ||
+        tables[table].status != SCHEDULETABLE_STOPPED) {
+        return OS_STATUS_ERROR;
+    }
+
+    for (uint32 i = 0; i < config->point_count; i++) {
+        if (config->points[i].offset >= config->duration || config->points[i].task >= TASK_COUNT ||
+            (i > 0u && config->points[i].offset < config->points[i - 1u].offset)) {
+            printf("[OS] Schedule table %u: invalid expiry point %u\n", table, i);
+            return OS_STATUS_ERROR;
+        }
+    }
+
+    alarm_config.counter = config->counter;
+    alarm_config.action = OS_ALARM_ACTION_CALLBACK;
+    alarm_config.task = TASK_IDLE;
+    alarm_config.event = 0;
+    alarm_config.callback = expiry_point_reached;
+    if (Os_ConfigureInternalAlarm(OS_SCHEDULETABLE_ALARM(table), &alarm_config) != OS_STATUS_OK) {
+        return OS_STATUS_ERROR;
+    }
+
+    tables[table].config = config;
+    return OS_STATUS_OK;
+}
+
+StatusType Os_StartScheduleTableRel(ScheduleTableType table, TickType offset) {
+    TickType now;
+
+    if (get_table(table) == NULL || offset == 0u ||
+        Os_GetCounterValue(tables[table].config->counter, &now) != OS_STATUS_OK) {
+        return OS_STATUS_ERROR;
+    }
+
+    return start_table(table, now + offset);
+}
+
+StatusType Os_StartScheduleTableAbs(ScheduleTableType table, TickType start) {
+    if (get_table(table) == NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    return start_table(table, start);
+}
+
+StatusType Os_StopScheduleTable(ScheduleTableType table) {
+    ScheduleTableControlBlock* stcb = get_table(table);
+    StatusType status = OS_STATUS_ERROR;
+
+    if (stcb == NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    Os_CounterLock(stcb->config->counter);
+    if (stcb->status != SCHEDULETABLE_STOPPED) {
+        Os_CancelInternalAlarm(OS_SCHEDULETABLE_ALARM(table));
+        stcb->status = SCHEDULETABLE_STOPPED;
+        status = OS_STATUS_OK;
+    }
+    Os_CounterUnlock(stcb->config->counter);
+
+    return status;
+}
+
+StatusType Os_GetScheduleTableStatus(ScheduleTableType table, ScheduleTableStatusRefType status) {
+    ScheduleTableControlBlock* stcb = get_table(table);
+
+    if (stcb == NULL || status == NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    Os_CounterLock(stcb->config->counter);
+    *status = stcb->status;
+    Os_CounterUnlock(stcb->config->counter);
+
+    return OS_STATUS_OK;
+}
@@ -0,0 +1,202 @@
+/**
+ * @file Os_Spinlock.c
+ * @brief AUTOSAR OS Abstraction Layer - Spinlocks
+ * @details Ticket spinlocks for data shared between cores. Each lock owns a
+ * cache line for its ticket words and a second one for the statistics,
+ * which only the holder writes, so waiters spinning on the ticket words do
+ * not steal the line from the holder.
+ *
+ * The emulated cores may share one host CPU, where spinning on a preempted
+ * holder burns the whole time slice. Waiters therefore spin for a bounded
+ * number of iterations and then sleep on the ticket word until the lock is
+ * handed on.
+ *
+ * Location: src/autosar/bsw/os/Os_Spinlock.c
+ */
+
+#define _GNU_SOURCE
+
+#include "Os.h"
+#include "Os_Internal.h"
+#include <limits.h>
+#include <linux/futex.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Busy-wait iterations before a waiter sleeps */
+#define OS_SPINLOCK_SPIN_LIMIT 1000u
+
+/* Spinlock Control Block */
+typedef struct {
+    _Alignas(OS_CACHE_LINE_SIZE) _Atomic uint32 next_ticket;
+    _Atomic uint32 now_serving;     /* Futex word the sleeping waiters wait on */
+    _Atomic uint32 sleepers;
+    _Alignas(OS_CACHE_LINE_SIZE) Os_SpinlockStatsType stats;  /* Written under the lock */
+} SpinlockControlBlock;
+
+static SpinlockControlBlock spinlocks[OS_SPINLOCK_COUNT];
+
+/* Spinlocks held by the calling thread, one bit per lock */
+_Static_assert(OS_SPINLOCK_COUNT <= 32u, "held_locks has one bit per spinlock");
+static _Thread_local uint32 held_locks = 0;
+
+static inline void cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ volatile("yield");
+#endif
+}
+
+static uint64_t get_raw_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Wait for 'ticket' to be served; returns with the lock held */
+static void acquire(SpinlockControlBlock* slcb, boolean count) {
+    uint32 ticket = atomic_fetch_add_explicit(&slcb->next_ticket, 1u, memory_order_relaxed);
+    uint32 serving = atomic_load_explicit(&slcb->now_serving, memory_order_acquire);
+    uint32 spins = 0;
+    uint32 sleeps = 0;
+    uint64_t wait_start;
+
+    if (serving == ticket) {
+        if (count) {
+            slcb->stats.acquisitions++;
+        }
+        return;
+    }
+
+    wait_start = get_raw_time_ns();
+    while (serving != ticket) {
+        if (spins < OS_SPINLOCK_SPIN_LIMIT) {
+            cpu_relax();
+            spins++;
+        } else {
+            /* The kernel rechecks now_serving, so a hand-over in between is not lost */
+            atomic_fetch_add(&slcb->sleepers, 1u);
+            syscall(SYS_futex, &slcb->now_serving, FUTEX_WAIT_PRIVATE, serving, NULL, NULL, 0);
+            atomic_fetch_sub(&slcb->sleepers, 1u);
+            sleeps++;
+        }
+        serving = atomic_load_explicit(&slcb->now_serving, memory_order_acquire);
+    }
+
+    if (count) {
+        uint64_t wait_ns = get_raw_time_ns() - wait_start;
+
+        slcb->stats.acquisitions++;
+        slcb->stats.contended++;
+        slcb->stats.sleeps += sleeps;
+        slcb->stats.spins += spins;
+        if (wait_ns > slcb->stats.max_wait_ns) {
+            slcb->stats.max_wait_ns = (wait_ns > UINT32_MAX) ? UINT32_MAX : (uint32)wait_ns;
+        }
+    }
+}
+
+/* Hand the lock to the next ticket */
+static void release(SpinlockControlBlock* slcb) {
+    atomic_fetch_add(&slcb->now_serving, 1u);
+
+    /* Tickets are served in order - wake every sleeper, the next one takes it */
+    if (atomic_load(&slcb->sleepers) != 0u) {
+        syscall(SYS_futex, &slcb->now_serving, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+void Os_SpinlockInit(void) {
+    for (uint32 l = 0; l < OS_SPINLOCK_COUNT; l++) {
+        atomic_store(&spinlocks[l].next_ticket, 0u);
+        atomic_store(&spinlocks[l].now_serving, 0u);
+        atomic_store(&spinlocks[l].sleepers, 0u);
+        spinlocks[l].stats = (Os_SpinlockStatsType){0};
+    }
+    held_locks = 0;
+}
+
+boolean Os_SpinlockHeld(void) {
+    return (held_locks != 0u) ? TRUE : FALSE;
+}
+
+StatusType Os_GetSpinlock(SpinlockIdType lock) {
+    /* Taking a lock twice on one thread would wait on itself forever */
+    if (lock >= OS_SPINLOCK_COUNT || (held_locks & (1u << lock)) != 0u) {
+        return OS_STATUS_ERROR;
+    }
+
+    acquire(&spinlocks[lock], TRUE);
+    held_locks |= 1u << lock;
+
+    return OS_STATUS_OK;
+}
+
+StatusType Os_ReleaseSpinlock(SpinlockIdType lock) {
+    if (lock >= OS_SPINLOCK_COUNT || (held_locks & (1u << lock)) == 0u) {
+        return OS_STATUS_ERROR;
+    }
+
+    held_locks &= ~(1u << lock);
+    release(&spinlocks[lock]);
+
+    return OS_STATUS_OK;
+}
+
+StatusType Os_TryToGetSpinlock(SpinlockIdType lock, TryToGetSpinlockType* success) {
+    SpinlockControlBlock* slcb;
+    uint32 ticket;
+
+    if (lock >= OS_SPINLOCK_COUNT || success == NULL || (held_locks & (1u << lock)) != 0u) {
+        return OS_STATUS_ERROR;
+    }
+
+    /* Free means no ticket is outstanding: draw one only if it is served at once */
+    slcb = &spinlocks[lock];
+    ticket = atomic_load_explicit(&slcb->now_serving, memory_order_relaxed);
+    if (atomic_compare_exchange_strong_explicit(&slcb->next_ticket, &ticket, ticket + 1u,
+                                                memory_order_acquire, memory_order_relaxed)) {
+        slcb->stats.acquisitions++;
+        held_locks |= 1u << lock;
+        *success = TRYTOGETSPINLOCK_SUCCESS;
+    } else {
+        *success = TRYTOGETSPINLOCK_NOSUCCESS;
+    }
+
+    return OS_STATUS_OK;
+}
+
+StatusType Os_GetSpinlockStats(SpinlockIdType lock, Os_SpinlockStatsType* stats) {
+    if (lock >= OS_SPINLOCK_COUNT || stats == NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    /* Read under the lock without counting it as an acquisition */
+    acquire(&spinlocks[lock], FALSE);
+    *stats = spinlocks[lock].stats;
+    release(&spinlocks[lock]);
+
+    return OS_STATUS_OK;
+}
+
+void Os_PrintSpinlockStats(void) {
+    for (uint32 l = 0; l < OS_SPINLOCK_COUNT; l++) {
+        Os_SpinlockStatsType stats;
+
+        Os_GetSpinlockStats(l, &stats);
+        if (stats.acquisitions == 0u) {
+            continue;
+        }
+        printf("[OS] Spinlock %u: %u acquisitions, %u contended (%u.%u%%), "
+               "%lu spins, %u sleeps, max wait %u us\n",
+               l, stats.acquisitions, stats.contended,
+               (uint32)((uint64)stats.contended * 100u / stats.acquisitions),
+               (uint32)((uint64)stats.contended * 1000u / stats.acquisitions % 10u),
+               (unsigned long)stats.spins, stats.sleeps, stats.max_wait_ns / 1000u);
+    }
+}
@@ -0,0 +1,307 @@
+/**
+ * @file Os_Trace.c
+ * @brief AUTOSAR OS Abstraction Layer - Execution trace recorder
+ * @details Every core records into a ring buffer of its own. Writers claim
+ * a record with one fetch-add on the head and publish it through the
+ * record's sequence word, so several threads of a core (task threads, job
+ * pool threads) can record at once without a lock. Os_DumpTrace() copies
+ * each record under its sequence word and skips the ones being written.
+ *
+ * Timestamps are raw TSC values, converted to time when dumping from two
+ * TSC / clock pairs taken at Os_StartTrace() and at the dump.
+ *
+ * Location: src/autosar/bsw/os/Os_Trace.c
+ */
+
+#define _GNU_SOURCE
+
+#include "Os.h"
+#include "Os_Internal.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+_Static_assert((OS_TRACE_BUFFER_SIZE & (OS_TRACE_BUFFER_SIZE - 1u)) == 0u,
+               "OS_TRACE_BUFFER_SIZE must be a power of two");
+
+/* One event; half a cache line */
+typedef struct {
+    _Atomic uint32 sequence;        /* Index + 1 once written, 0 while being written */
+    uint8 event;
+    uint8 task;
+    uint32 id;
+    uint32 value;
+    uint64 timestamp;
+    const char* name;
+} TraceRecordType;
+
+/* Trace buffer of one core */
+typedef struct {
+    _Alignas(OS_CACHE_LINE_SIZE) _Atomic uint32 head;  /* Next record to claim */
+    _Alignas(OS_CACHE_LINE_SIZE) TraceRecordType records[OS_TRACE_BUFFER_SIZE];
+} TraceBufferType;
+
+/* Record copied out for the dump */
+typedef struct {
+    TraceRecordType record;
+    CoreIdType core;
+    uint32 index;
+} TraceSnapshotType;
+
+static TraceBufferType buffers[OS_CORE_COUNT];
+static _Atomic boolean trace_enabled = FALSE;
+
+/* Timestamp and clock at Os_StartTrace(), the origin of the dump */
+static uint64 start_timestamp = 0;
+static uint64 start_ns = 0;
+
+/* Names of the events recorded without one */
+static const char* const event_names[OS_TRACE_EVENT_COUNT] = {
+    [OS_TRACE_TASK_START]     = "Task",
+    [OS_TRACE_TASK_END]       = "Task",
+    [OS_TRACE_RUNNABLE_ENTRY] = "Runnable",
+    [OS_TRACE_RUNNABLE_EXIT]  = "Runnable",
+    [OS_TRACE_SIGNAL_WRITE]   = "Signal write",
+    [OS_TRACE_PDU_TX]         = "PDU TX",
+    [OS_TRACE_PDU_RX]         = "PDU RX",
+};
+
+static uint64 get_raw_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64)ts.tv_sec * 1000000000u + (uint64)ts.tv_nsec;
+}
+
+/* Cheapest monotonic host timestamp */
+static inline uint64 read_timestamp(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return get_raw_time_ns();
+#endif
+}
+
+static void clear_buffers(void) {
+    for (uint32 c = 0; c < OS_CORE_COUNT; c++) {
+        atomic_store(&buffers[c].head, 0u);
+        for (uint32 i = 0; i < OS_TRACE_BUFFER_SIZE; i++) {
+            atomic_store_explicit(&buffers[c].records[i].sequence, 0u, memory_order_relaxed);
+        }
+    }
+}
+
+void Os_TraceInit(void) {
+    atomic_store(&trace_enabled, FALSE);
+    clear_buffers();
+}
+
+void Os_StartTrace(void) {
+    atomic_store(&trace_enabled, FALSE);
+    clear_buffers();
+    start_ns = get_raw_time_ns();
+    start_timestamp = read_timestamp();
+    atomic_store(&trace_enabled, TRUE);
+}
+
+void Os_StopTrace(void) {
+    atomic_store(&trace_enabled, FALSE);
+}
+
+void Os_TraceRecord(Os_TraceEventType event, TaskType task, uint32 id, uint32 value,
+                    const char* name) {
+    if (!atomic_load_explicit(&trace_enabled, memory_order_relaxed)) {
+        return;
+    }
+
+    TraceBufferType* buffer = &buffers[Os_GetCoreID()];
+    uint32 index = atomic_fetch_add_explicit(&buffer->head, 1u, memory_order_relaxed);
+    TraceRecordType* record = &buffer->records[index & (OS_TRACE_BUFFER_SIZE - 1u)];
+
+    /* Invalidate the record before overwriting it, like a seqlock writer */
+    atomic_store_explicit(&record->sequence, 0u, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    record->event = (uint8)event;
+    record->task = (uint8)task;
+    record->id = id;
+    record->value = value;
+    record->timestamp = read_timestamp();
+    record->name = (name != NULL) ? name : event_names[event];
+    atomic_store_explicit(&record->sequence, index + 1u, memory_order_release);
+}
+
+void Os_TraceEvent(Os_TraceEventType event, uint32 id, uint32 value) {
+    if (event >= OS_TRACE_EVENT_COUNT) {
+        return;
+    }
+    Os_TraceRecord(event, Os_GetCurrentTask(), id, value, NULL);
+}
+
+/* Copy the records still in a core's buffer, oldest first */
+static uint32 snapshot_core(CoreIdType core, TraceSnapshotType* out) {
+    TraceBufferType* buffer = &buffers[core];
+    uint32 head = atomic_load_explicit(&buffer->head, memory_order_acquire);
+    uint32 first = (head > OS_TRACE_BUFFER_SIZE) ? head - OS_TRACE_BUFFER_SIZE : 0u;
+    uint32 count = 0;
+
+    for (uint32 index = first; index != head; index++) {
+        TraceRecordType* record = &buffer->records[index & (OS_TRACE_BUFFER_SIZE - 1u)];
+        uint32 before = atomic_load_explicit(&record->sequence, memory_order_acquire);
+
+        if (before != index + 1u) {
+            continue;   /* Still being written, or already overwritten */
+        }
+        out[count].record.event = record->event;
+        out[count].record.task = record->task;
+        out[count].record.id = record->id;
+        out[count].record.value = record->value;
+        out[count].record.timestamp = record->timestamp;
+        out[count].record.name = record->name;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&record->sequence, memory_order_relaxed) != before) {
+            continue;
+        }
+        out[count].core = core;
+        out[count].index = index;
+        count++;
+    }
+
+    return count;
+}
+
+/* Timestamp order; records of one core with equal timestamps keep their order */
+static int compare_snapshots(const void* a, const void* b) {
+    const TraceSnapshotType* x = a;
+    const TraceSnapshotType* y = b;
+
+    if (x->record.timestamp != y->record.timestamp) {
+        return (x->record.timestamp < y->record.timestamp) ? -1 : 1;
+    }
+    if (x->core != y->core) {
+        return (x->core < y->core) ? -1 : 1;
+    }
+    return (x->index < y->index) ? -1 : (x->index > y->index);
+}
+
+static void write_string(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* c = text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', file);
+        }
+        fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+/* Common fields of one Chrome trace event */
+static void write_event_head(FILE* file, const char* phase, const TraceSnapshotType* snapshot,
+                             double time_us) {
+    fputs(",\n{\"name\":", file);
+    write_string(file, snapshot->record.name);
+    fprintf(file, ",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":%u,\"tid\":%u", phase, time_us,
+            snapshot->core, snapshot->record.task);
+}
+
+StatusType Os_DumpTrace(const char* path) {
+    TraceSnapshotType* snapshots;
+    boolean named[OS_CORE_COUNT][TASK_COUNT] = {{FALSE}};
+    uint32 count = 0;
+    FILE* file;
+
+    if (path == NULL) {
+        return OS_STATUS_ERROR;
+    }
+
+    snapshots = malloc(sizeof(TraceSnapshotType) * OS_TRACE_BUFFER_SIZE * OS_CORE_COUNT);
+    if (snapshots == NULL) {
+        return OS_STATUS_ERROR;
+    }
+    for (CoreIdType c = 0; c < OS_CORE_COUNT; c++) {
+        count += snapshot_core(c, &snapshots[count]);
+    }
+
+    /* Host time per timestamp unit, measured over the whole recording */
+    uint64 end_timestamp = read_timestamp();
+    uint64 end_ns = get_raw_time_ns();
+    double ns_per_unit = (end_timestamp > start_timestamp) ?
+        (double)(end_ns - start_ns) / (double)(end_timestamp - start_timestamp) : 1.0;
+
+    qsort(snapshots, count, sizeof(TraceSnapshotType), compare_snapshots);
+
+    file = fopen(path, "w");
+    if (file == NULL) {
+        free(snapshots);
+        return OS_STATUS_ERROR;
+    }
+
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+    fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"Core 0\"}}", file);
+    for (CoreIdType c = 1; c < OS_CORE_COUNT; c++) {
+        fprintf(file, ",\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,"
+                "\"args\":{\"name\":\"Core %u\"}}", c, c);
+    }
+
+    for (uint32 i = 0; i < count; i++) {
+        const TraceSnapshotType* snapshot = &snapshots[i];
+        const TraceRecordType* record = &snapshot->record;
+        double time_us = (double)(sint64)(record->timestamp - start_timestamp) * ns_per_unit / 1000.0;
+
+        /* Tracks are named after the first activation of their task */
+        if (record->event == OS_TRACE_TASK_START && record->task < TASK_COUNT &&
+            !named[snapshot->core][record->task]) {
+            named[snapshot->core][record->task] = TRUE;
+            fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,"
+                    "\"args\":{\"name\":", snapshot->core, record->task);
+            write_string(file, record->name);
+            fputs("}}", file);
+        }
+
+        switch (record->event) {
+        case OS_TRACE_TASK_START:
+            write_event_head(file, "B", snapshot, time_us);
+            fprintf(file, ",\"cat\":\"task\",\"args\":{\"activation\":%u}}", record->value);
+            break;
+        case OS_TRACE_RUNNABLE_ENTRY:
+            write_event_head(file, "B", snapshot, time_us);
+            fputs(",\"cat\":\"runnable\"}", file);
+            break;
+        case OS_TRACE_TASK_END:
+        case OS_TRACE_RUNNABLE_EXIT:
+            write_event_head(file, "E", snapshot, time_us);
+            fputs("}", file);
+            break;
+        case OS_TRACE_SIGNAL_WRITE:
+            write_event_head(file, "i", snapshot, time_us);
+            fprintf(file, ",\"cat\":\"rte\",\"s\":\"t\",\"args\":{\"signal\":%u,\"value\":%u}}",
+                    record->id, record->value);
+            break;
+        case OS_TRACE_PDU_TX:
+            write_event_head(file, "i", snapshot, time_us);
+            fprintf(file, ",\"cat\":\"com\",\"s\":\"t\",\"args\":{\"pdu\":%u,\"id\":\"0x%03X\"}}",
+                    record->id, record->value);
+            break;
+        case OS_TRACE_PDU_RX:
+            write_event_head(file, "i", snapshot, time_us);
+            fprintf(file, ",\"cat\":\"com\",\"s\":\"t\",\"args\":{\"pdu\":%u,\"length\":%u}}",
+                    record->id, record->value);
+            break;
+        default:
+            break;
+        }
+    }
+    fputs("\n]}\n", file);
+
+    free(snapshots);
+    if (fclose(file) != 0) {
+        return OS_STATUS_ERROR;
+    }
+    printf("[OS] Trace: %u events written to %s\n", count, path);
+
+    return OS_STATUS_OK;
+}
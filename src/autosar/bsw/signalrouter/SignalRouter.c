@@ -2,65 +2,860 @@
  * @file SignalRouter.c
  * @brief Internal Signal Router - Implementation
  * @details Manages in-memory signal exchange between SWCs
- * 
+ *
+ * uint32 signals, most of them, are one atomic word each: their values are
+ * packed 16 per cache line, and so are their versions. A writer stores the
+ * value, then bumps the version; a reader loads the version, then the
+ * value, so it never sees a version without its value.
+ *
+ * Every larger signal has a slot header and SIGNALROUTER_BUFFER_COUNT
+ * buffers in one aligned pool. A writer claims a buffer that is neither the
+ * latest value nor held by a reader with a CAS on its reader count, fills
+ * it, then publishes it as the latest and bumps the signal's version with
+ * one CAS on the state word.
+ * Writers never wait for each other: each fills a buffer of its own, and
+ * the last one committed is the latest value. Copying readers copy the
+ * latest buffer and retry if the state moved meanwhile, so they never
+ * write shared memory; zero-copy readers pin the latest buffer with a
+ * reader count instead, so writers skip it until it is released. A writer
+ * that finds every spare buffer held fails at once instead of waiting.
+ *
+ * Subscribers of a signal are called by the writer after each committed
+ * write, so a signal nobody subscribed to costs its writers one load.
+ * Change trackers keep a dense bitmap of the signals written since their
+ * last collection; the writer only touches a tracker's word when its bit
+ * is still clear.
+ *
+ * Values, slots and buffers form one database that refers to its buffers by
+ * offset, so it works unchanged in a POSIX shared memory segment mapped at
+ * a different address in each process (SignalRouter_InitShared()). A
+ * layout header lets every process check that it was built with the same
+ * signal configuration before using it. Subscribers and trackers stay
+ * local to each process. Every claimed buffer records the PID of its
+ * writer before it is flagged, so a process that dies in the middle of a
+ * write does not hold the buffer forever: a writer or zero-copy reader that
+ * finds it held releases it once that process is gone.
+ *
  * Location: src/autosar/bsw/signalrouter/SignalRouter.c
  */
 
+#define _GNU_SOURCE
+
 #include "SignalRouter.h"
+#include "Rte_Type.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Host cache line size - every slot and every buffer owns whole lines */
+#define SIGNALROUTER_CACHE_LINE_SIZE 64u
+
+/* Reader count flag of the buffer a writer is filling */
+#define SIGNALROUTER_WRITING 0x80000000u
+
+/* Layout header identification; bump the version when the layout changes */
+#define SIGNALROUTER_MAGIC   0x53524442u    /* "SRDB" */
+#define SIGNALROUTER_VERSION 5u
+
+/* How long an attaching process waits for the creator to lay the database out */
+#define SIGNALROUTER_ATTACH_TIMEOUT_MS 1000u
+
+/* Size and alignment of a signal's data type */
+typedef struct {
+    uint32 size;
+    uint32 alignment;
+} SignalRouter_SignalConfigType;
+
+/* Data type of every signal, as an RTE generator would emit it */
+static const SignalRouter_SignalConfigType signal_config[SIGNAL_COUNT] = {
+    [SIGNAL_INPUT_A]       = { sizeof(uint32), _Alignof(uint32) },
+    [SIGNAL_INPUT_B]       = { sizeof(uint32), _Alignof(uint32) },
+    [SIGNAL_OUTPUT_RESULT] = { sizeof(uint32), _Alignof(uint32) },
+    [SIGNAL_STATUS]        = { sizeof(uint32), _Alignof(uint32) },
+    [SIGNAL_KATA_RESULT]   = { sizeof(Rte_KataResultType), _Alignof(Rte_KataResultType) },
+};
+
+/* Signals larger than a uint32 in signal_config - only these have a slot and buffers */
+#define SIGNALROUTER_SLOT_COUNT 1u
+
+/* Slot of a signal, SIGNALROUTER_NO_SLOT for a packed uint32 signal */
+#define SIGNALROUTER_NO_SLOT 0xFFFFFFFFu
+
+/* Header of a signal with buffers, on cache lines of its own */
+typedef struct {
+    _Alignas(SIGNALROUTER_CACHE_LINE_SIZE) _Atomic uint64 state;  /* Version << 32 | latest buffer */
+    _Atomic uint32 readers[SIGNALROUTER_BUFFER_COUNT];  /* Zero-copy readers | SIGNALROUTER_WRITING */
+    _Atomic uint32 owner[SIGNALROUTER_BUFFER_COUNT];    /* PID of the writer, 0 = none */
+    uint32 signal;
+    uint32 size;
+    uint32 stride;                  /* Distance between the buffers */
+    uint32 offset;                  /* Of the first buffer in the pool */
+} SignalRouter_SignalSlotType;
+
+/* Layout header, checked by every process attaching to a shared database */
+typedef struct {
+    _Alignas(SIGNALROUTER_CACHE_LINE_SIZE) uint32 magic;
+    uint32 version;
+    uint32 size;                    /* sizeof(SignalRouter_DatabaseType) */
+    uint32 signal_count;
+    uint32 buffer_count;
+    _Atomic uint32 ready;           /* Set once the creator laid the database out */
+} SignalRouter_HeaderType;
+
+/* Signal database: header, packed uint32 signals, slots and the buffer pool
+ * of the larger signals */
+typedef struct {
+    SignalRouter_HeaderType header;
+    _Alignas(SIGNALROUTER_CACHE_LINE_SIZE) _Atomic uint32 value[SIGNAL_COUNT];      /* uint32 signals only */
+    _Alignas(SIGNALROUTER_CACHE_LINE_SIZE) _Atomic uint32 version[SIGNAL_COUNT];    /* uint32 signals only */
+    SignalRouter_SignalSlotType slots[SIGNALROUTER_SLOT_COUNT];
+    _Alignas(SIGNALROUTER_CACHE_LINE_SIZE) uint8 pool[SIGNALROUTER_POOL_SIZE];
+} SignalRouter_DatabaseType;
+
+/* Internal signal database (private to this module, shared by the SWC and BSW cores),
+ * or the one mapped from shared memory */
+static SignalRouter_DatabaseType local_database;
+static SignalRouter_DatabaseType* database = &local_database;
+static boolean database_shared = FALSE;
+
+/* PID recorded on the buffers this process claims */
+static uint32 process_id;
+
+/* Slot of every signal, from signal_config */
+static uint32 signal_slot[SIGNAL_COUNT];
+
+/* Parts of a slot's state word */
+#define STATE_VERSION(state) ((SignalRouter_VersionType)((state) >> 32))
+#define STATE_BUFFER(state) ((uint32)(state))
+
+/* Buffer b of a signal slot */
+#define SLOT_BUFFER(slot, b) (&database->pool[(slot)->offset + (b) * (slot)->stride])
 
-/* Internal signal database (private to this module) */
-static SignalRouter_SignalDataType signal_db[SIGNAL_COUNT];
+/* A valid signal packed as one word, and the slot of one that is not */
+#define SIGNAL_PACKED(signalId) (signal_slot[signalId] == SIGNALROUTER_NO_SLOT)
+#define SIGNAL_SLOT(signalId) (&database->slots[signal_slot[signalId]])
+
+/* Subscribers of a signal, configured before the writers start */
+typedef struct {
+    uint32 count;
+    SignalRouter_NotificationType notification[SIGNALROUTER_SUBSCRIBER_COUNT];
+} SignalRouter_SubscriberListType;
+
+static SignalRouter_SubscriberListType signal_subscribers[SIGNAL_COUNT];
+
+/* Changed signals of one tracker, on cache lines of its own */
+typedef struct {
+    _Alignas(SIGNALROUTER_CACHE_LINE_SIZE) _Atomic uint64 dirty[SIGNALROUTER_BITMAP_WORDS];
+} SignalRouter_TrackerBitmapType;
+
+static SignalRouter_TrackerBitmapType tracker_bitmap[SIGNALROUTER_TRACKER_COUNT];
+static uint32 tracker_count = 0;
+
+static uint32 align_up(uint32 value, uint32 alignment) {
+    return (value + alignment - 1u) / alignment * alignment;
+}
+
+/* Forget the subscribers and trackers of this process */
+static void reset_local(void) {
+    process_id = (uint32)getpid();
+    for (uint32 i = 0; i < SIGNAL_COUNT; i++) {
+        signal_subscribers[i].count = 0;
+    }
+    tracker_count = 0;
+}
+
+/* Give every signal larger than a uint32 a slot, in signal order */
+static Std_ReturnType map_signals(void) {
+    uint32 slots = 0;
+
+    for (uint32 i = 0; i < SIGNAL_COUNT; i++) {
+        signal_slot[i] = SIGNALROUTER_NO_SLOT;
+        if (signal_config[i].size == sizeof(uint32)) {
+            continue;
+        }
+        if (slots >= SIGNALROUTER_SLOT_COUNT) {
+            printf("[SignalRouter] ERROR: More than %u signals larger than a uint32\n", SIGNALROUTER_SLOT_COUNT);
+            return E_NOT_OK;
+        }
+        signal_slot[i] = slots++;
+    }
+    return E_OK;
+}
+
+/* Lay out a database and set all signals to zero; returns the pool bytes used */
+static Std_ReturnType layout_database(SignalRouter_DatabaseType* db, uint32* used) {
+    uint32 offset = 0;
+
+    for (uint32 i = 0; i < SIGNAL_COUNT; i++) {
+        atomic_store(&db->value[i], 0u);
+        atomic_store(&db->version[i], 0u);
+    }
+
+    /* Lay out the buffers; each starts on a cache line so signals never share one */
+    for (uint32 i = 0; i < SIGNAL_COUNT; i++) {
+        if (SIGNAL_PACKED(i)) {
+            continue;
+        }
+        SignalRouter_SignalSlotType* slot = &db->slots[signal_slot[i]];
+        uint32 alignment = signal_config[i].alignment;
+
+        if (alignment < SIGNALROUTER_CACHE_LINE_SIZE) {
+            alignment = SIGNALROUTER_CACHE_LINE_SIZE;
+        }
+        offset = align_up(offset, alignment);
+        slot->signal = i;
+        slot->size = signal_config[i].size;
+        slot->stride = align_up(slot->size, alignment);
+        if (offset + slot->stride * SIGNALROUTER_BUFFER_COUNT > SIGNALROUTER_POOL_SIZE) {
+            printf("[SignalRouter] ERROR: Signals need more than %u bytes\n", SIGNALROUTER_POOL_SIZE);
+            return E_NOT_OK;
+        }
+        slot->offset = offset;
+        offset += slot->stride * SIGNALROUTER_BUFFER_COUNT;
+
+        /* Initialize all signals to zero */
+        memset(&db->pool[slot->offset], 0, slot->stride * SIGNALROUTER_BUFFER_COUNT);
+        atomic_store(&slot->state, 0u);
+        for (uint32 b = 0; b < SIGNALROUTER_BUFFER_COUNT; b++) {
+            atomic_store(&slot->readers[b], 0u);
+            atomic_store(&slot->owner[b], 0u);
+        }
+    }
+
+    db->header.magic = SIGNALROUTER_MAGIC;
+    db->header.version = SIGNALROUTER_VERSION;
+    db->header.size = sizeof(SignalRouter_DatabaseType);
+    db->header.signal_count = SIGNAL_COUNT;
+    db->header.buffer_count = SIGNALROUTER_BUFFER_COUNT;
+    atomic_store_explicit(&db->header.ready, 1u, memory_order_release);
+    *used = offset;
+
+    return E_OK;
+}
+
+/* Check that another process laid the database out for the same signals */
+static Std_ReturnType check_database(const SignalRouter_DatabaseType* db) {
+    if (db->header.magic != SIGNALROUTER_MAGIC || db->header.version != SIGNALROUTER_VERSION ||
+        db->header.size != sizeof(SignalRouter_DatabaseType) || db->header.signal_count != SIGNAL_COUNT ||
+        db->header.buffer_count != SIGNALROUTER_BUFFER_COUNT) {
+        printf("[SignalRouter] ERROR: Shared database has another layout "
+               "(version %u, %u bytes, %u signals, %u buffers)\n",
+               db->header.version, db->header.size, db->header.signal_count, db->header.buffer_count);
+        return E_NOT_OK;
+    }
+    for (uint32 i = 0; i < SIGNAL_COUNT; i++) {
+        if (SIGNAL_PACKED(i)) {
+            continue;
+        }
+        const SignalRouter_SignalSlotType* slot = &db->slots[signal_slot[i]];
+
+        if (slot->signal != i || slot->size != signal_config[i].size) {
+            printf("[SignalRouter] ERROR: Signal %u has %u bytes in the shared database, %u here\n",
+                   i, (slot->signal == i) ? slot->size : 0u, signal_config[i].size);
+            return E_NOT_OK;
+        }
+    }
+    return E_OK;
+}
+
+static void sleep_ms(void) {
+    nanosleep(&(struct timespec){ 0, 1000000 }, NULL);
+}
 
 Std_ReturnType SignalRouter_Init(void) {
-    /* Initialize all signals to zero */
-    memset(signal_db, 0, sizeof(signal_db));
-    
-    printf("[SignalRouter] Initialized - %u internal signals\n", SIGNAL_COUNT);
+    uint32 used;
+
+    SignalRouter_Deinit();
+    reset_local();
+    if (map_signals() != E_OK || layout_database(&local_database, &used) != E_OK) {
+        return E_NOT_OK;
+    }
+
+    printf("[SignalRouter] Initialized - %u internal signals, %u buffer bytes\n", SIGNAL_COUNT, used);
     printf("[SignalRouter] Note: This handles INTERNAL routing, not bus communication\n");
-    
+
     return E_OK;
 }
 
-Std_ReturnType SignalRouter_Write(SignalRouter_SignalIdType signalId, uint32 value) {
+Std_ReturnType SignalRouter_InitShared(const char* name) {
+    SignalRouter_DatabaseType* db;
+    struct stat info;
+    boolean created = TRUE;
+    uint32 waited = 0;
+    uint32 used = 0;
+    int fd;
+
+    if (name == NULL) {
+        return E_NOT_OK;
+    }
+    SignalRouter_Deinit();
+    reset_local();
+    if (map_signals() != E_OK) {
+        return E_NOT_OK;
+    }
+
+    /* The first process creates and lays out the segment, the others attach */
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        created = FALSE;
+        fd = shm_open(name, O_RDWR, 0);
+    }
+    if (fd < 0) {
+        printf("[SignalRouter] ERROR: Cannot open shared memory %s: %s\n", name, strerror(errno));
+        return E_NOT_OK;
+    }
+
+    if (created) {
+        if (ftruncate(fd, sizeof(SignalRouter_DatabaseType)) != 0) {
+            printf("[SignalRouter] ERROR: Cannot size shared memory %s: %s\n", name, strerror(errno));
+            close(fd);
+            shm_unlink(name);
+            return E_NOT_OK;
+        }
+    } else {
+        /* Mapping past the end of a segment the creator has not sized yet would fault */
+        while (fstat(fd, &info) == 0 && (size_t)info.st_size < sizeof(SignalRouter_DatabaseType) &&
+               waited++ < SIGNALROUTER_ATTACH_TIMEOUT_MS) {
+            sleep_ms();
+        }
+        if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(SignalRouter_DatabaseType)) {
+            printf("[SignalRouter] ERROR: Shared memory %s is too small\n", name);
+            close(fd);
+            return E_NOT_OK;
+        }
+    }
+
+    db = mmap(NULL, sizeof(SignalRouter_DatabaseType), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (db == MAP_FAILED) {
+        printf("[SignalRouter] ERROR: Cannot map shared memory %s: %s\n", name, strerror(errno));
+        if (created) {
+            shm_unlink(name);
+        }
+        return E_NOT_OK;
+    }
+
+    if (created) {
+        if (layout_database(db, &used) != E_OK) {
+            munmap(db, sizeof(SignalRouter_DatabaseType));
+            shm_unlink(name);
+            return E_NOT_OK;
+        }
+    } else {
+        while (atomic_load_explicit(&db->header.ready, memory_order_acquire) == 0u &&
+               waited++ < SIGNALROUTER_ATTACH_TIMEOUT_MS) {
+            sleep_ms();
+        }
+        if (atomic_load_explicit(&db->header.ready, memory_order_acquire) == 0u || check_database(db) != E_OK) {
+            printf("[SignalRouter] ERROR: Shared memory %s holds no usable signal database\n", name);
+            munmap(db, sizeof(SignalRouter_DatabaseType));
+            return E_NOT_OK;
+        }
+    }
+
+    database = db;
+    database_shared = TRUE;
+    printf("[SignalRouter] %s shared database %s - %u internal signals, %u bytes\n",
+           created ? "Created" : "Attached to", name, SIGNAL_COUNT,
+           (uint32)sizeof(SignalRouter_DatabaseType));
+
+    return E_OK;
+}
+
+void SignalRouter_Deinit(void) {
+    if (database_shared) {
+        munmap(database, sizeof(SignalRouter_DatabaseType));
+        database = &local_database;
+        database_shared = FALSE;
+    }
+}
+
+Std_ReturnType SignalRouter_RemoveShared(const char* name) {
+    if (name == NULL || shm_unlink(name) != 0) {
+        return E_NOT_OK;
+    }
+    return E_OK;
+}
+
+uint32 SignalRouter_GetSize(SignalRouter_SignalIdType signalId) {
+    return (signalId < SIGNAL_COUNT) ? signal_config[signalId].size : 0u;
+}
+
+/* Record this process as the writer of buffer b of a shared signal; FALSE if another one is */
+static boolean claim_owner(SignalRouter_SignalSlotType* slot, uint32 b) {
+    uint32 none = 0;
+
+    return !database_shared ||
+           atomic_compare_exchange_strong_explicit(&slot->owner[b], &none, process_id,
+                                                   memory_order_relaxed, memory_order_relaxed);
+}
+
+/* Forget the writer of buffer b, after its claim was released */
+static void release_owner(SignalRouter_SignalSlotType* slot, uint32 b) {
+    if (database_shared) {
+        atomic_store_explicit(&slot->owner[b], 0u, memory_order_release);
+    }
+}
+
+/* Claim a buffer of a valid signal to write; NULL if readers and writers hold all spare ones */
+static void* claim_buffer(SignalRouter_SignalSlotType* slot) {
+    uint32 latest = STATE_BUFFER(atomic_load_explicit(&slot->state, memory_order_relaxed));
+
+    /* Claim a buffer that is not the latest and has no reader or writer. In a
+     * shared database the PID is recorded first, so every claim has an owner */
+    for (uint32 b = 0; b < SIGNALROUTER_BUFFER_COUNT; b++) {
+        uint32 expected = 0;
+
+        if (b == latest || !claim_owner(slot, b)) {
+            continue;
+        }
+        if (!atomic_compare_exchange_strong_explicit(&slot->readers[b], &expected, SIGNALROUTER_WRITING,
+                                                     memory_order_acquire, memory_order_relaxed)) {
+            release_owner(slot, b);
+            continue;
+        }
+
+        /* Another writer may have published it since; a buffer is published before
+         * its claim is released, so the claim sees that */
+        if (STATE_BUFFER(atomic_load_explicit(&slot->state, memory_order_acquire)) == b) {
+            atomic_fetch_and_explicit(&slot->readers[b], ~SIGNALROUTER_WRITING, memory_order_release);
+            release_owner(slot, b);
+            continue;
+        }
+        return SLOT_BUFFER(slot, b);
+    }
+
+    return NULL;
+}
+
+/* Release buffer b of a shared signal if the process that claimed it is gone */
+static void recover_buffer(SignalRouter_SignalSlotType* slot, uint32 b) {
+    uint32 owner = atomic_load_explicit(&slot->owner[b], memory_order_relaxed);
+
+    if (!database_shared || owner == 0u || owner == process_id ||
+        kill((pid_t)owner, 0) == 0 || errno != ESRCH) {
+        return;
+    }
+
+    /* Take the claim over, so only one process releases it and no new writer
+     * claims the buffer before its flag is cleared */
+    if (atomic_compare_exchange_strong_explicit(&slot->owner[b], &owner, process_id,
+                                                memory_order_acquire, memory_order_relaxed)) {
+        atomic_fetch_and_explicit(&slot->readers[b], ~SIGNALROUTER_WRITING, memory_order_release);
+        release_owner(slot, b);
+        printf("[SignalRouter] Released buffer %u of signal %u held by dead process %u\n",
+               b, slot->signal, owner);
+    }
+}
+
+/* Claim a buffer of a valid signal to write without waiting; NULL if none is free */
+static void* begin_write(SignalRouter_SignalSlotType* slot) {
+    void* buffer = claim_buffer(slot);
+
+    /* In a shared database, buffers may be held by a writer process that died */
+    if (buffer == NULL && database_shared) {
+        for (uint32 b = 0; b < SIGNALROUTER_BUFFER_COUNT; b++) {
+            recover_buffer(slot, b);
+        }
+        buffer = claim_buffer(slot);
+    }
+    return buffer;
+}
+
+/* Buffer index of a pointer into a slot's buffers, SIGNALROUTER_BUFFER_COUNT if none */
+static uint32 buffer_index(const SignalRouter_SignalSlotType* slot, const void* data) {
+    const uint8* first = SLOT_BUFFER(slot, 0u);
+
+    if ((const uint8*)data < first) {
+        return SIGNALROUTER_BUFFER_COUNT;
+    }
+    uint32 b = (uint32)((const uint8*)data - first) / slot->stride;
+    return (b < SIGNALROUTER_BUFFER_COUNT && SLOT_BUFFER(slot, b) == data) ? b : SIGNALROUTER_BUFFER_COUNT;
+}
+
+/* Flag a valid signal changed in every tracker and call its subscribers */
+static void notify_write(SignalRouter_SignalIdType signalId) {
+    /* Mark the signal changed; a load suffices while the tracker has not collected it.
+     * The fence pairs with the one in SignalRouter_CollectChanged(): a writer that
+     * sees its bit still set, yet cleared right after, has its value read by the collector */
+    uint64 bit = 1ull << (signalId % 64u);
+    if (tracker_count != 0u) {
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+    for (uint32 t = 0; t < tracker_count; t++) {
+        _Atomic uint64* word = &tracker_bitmap[t].dirty[signalId / 64u];
+
+        if ((atomic_load_explicit(word, memory_order_relaxed) & bit) == 0u) {
+            atomic_fetch_or_explicit(word, bit, memory_order_release);
+        }
+    }
+
+    /* Subscribers may write the signal themselves */
+    const SignalRouter_SubscriberListType* subscribers = &signal_subscribers[signalId];
+    for (uint32 i = 0; i < subscribers->count; i++) {
+        subscribers->notification[i](signalId);
+    }
+}
+
+/* Publish the claimed buffer b of a valid signal with buffers and notify its subscribers */
+static void commit_write(SignalRouter_SignalIdType signalId, uint32 b) {
+    SignalRouter_SignalSlotType* slot = SIGNAL_SLOT(signalId);
+    uint64 state = atomic_load_explicit(&slot->state, memory_order_relaxed);
+
+    /* Publish the buffer with the next version, then release the claim; the
+     * buffer it replaces is free for writers again unless a reader holds it */
+    while (!atomic_compare_exchange_weak_explicit(&slot->state, &state,
+                                                  ((uint64)(STATE_VERSION(state) + 1u) << 32) | b,
+                                                  memory_order_acq_rel, memory_order_relaxed)) {
+    }
+    atomic_fetch_and_explicit(&slot->readers[b], ~SIGNALROUTER_WRITING, memory_order_release);
+    release_owner(slot, b);
+    notify_write(signalId);
+}
+
+/* Copy the latest value of a valid signal with buffers; returns its version */
+static SignalRouter_VersionType read_copy(const SignalRouter_SignalSlotType* slot, void* data) {
+    uint64 before;
+    uint64 after;
+
+    /* Retry until no write was published during the copy */
+    do {
+        before = atomic_load_explicit(&slot->state, memory_order_acquire);
+        memcpy(data, SLOT_BUFFER(slot, STATE_BUFFER(before)), slot->size);
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&slot->state, memory_order_relaxed);
+    } while (before != after);
+
+    return STATE_VERSION(before);
+}
+
+/* Copy the latest value of a valid signal; returns its version */
+static SignalRouter_VersionType read_value(SignalRouter_SignalIdType signalId, void* data) {
+    SignalRouter_VersionType version;
+    uint32 value;
+
+    if (!SIGNAL_PACKED(signalId)) {
+        return read_copy(SIGNAL_SLOT(signalId), data);
+    }
+
+    /* The version is stored after the value, so the value is at least as new */
+    version = atomic_load_explicit(&database->version[signalId], memory_order_acquire);
+    value = atomic_load_explicit(&database->value[signalId], memory_order_relaxed);
+    memcpy(data, &value, sizeof(uint32));
+    return version;
+}
+
+/* Write a valid signal and notify its subscribers; E_NOT_OK if no buffer is free */
+static Std_ReturnType write_value(SignalRouter_SignalIdType signalId, const void* data) {
+    SignalRouter_SignalSlotType* slot;
+    uint32 value;
+    void* buffer;
+
+    if (SIGNAL_PACKED(signalId)) {
+        memcpy(&value, data, sizeof(uint32));
+        atomic_store_explicit(&database->value[signalId], value, memory_order_relaxed);
+        atomic_fetch_add_explicit(&database->version[signalId], 1u, memory_order_release);
+        notify_write(signalId);
+        return E_OK;
+    }
+
+    slot = SIGNAL_SLOT(signalId);
+    buffer = begin_write(slot);
+    if (buffer == NULL) {
+        return E_NOT_OK;
+    }
+    memcpy(buffer, data, slot->size);
+    commit_write(signalId, buffer_index(slot, buffer));
+    return E_OK;
+}
+
+void* SignalRouter_WriteBegin(SignalRouter_SignalIdType signalId) {
     /* Validate signal ID */
     if (signalId >= SIGNAL_COUNT) {
         printf("[SignalRouter] ERROR: Invalid signal ID %u\n", signalId);
+        return NULL;
+    }
+    if (SIGNAL_PACKED(signalId)) {
+        printf("[SignalRouter] ERROR: Signal %u is a uint32 without buffers\n", signalId);
+        return NULL;
+    }
+
+    return begin_write(SIGNAL_SLOT(signalId));
+}
+
+Std_ReturnType SignalRouter_WriteCommit(SignalRouter_SignalIdType signalId, void* data) {
+    uint32 b;
+
+    if (signalId >= SIGNAL_COUNT || data == NULL || SIGNAL_PACKED(signalId)) {
+        return E_NOT_OK;
+    }
+
+    b = buffer_index(SIGNAL_SLOT(signalId), data);
+    if (b >= SIGNALROUTER_BUFFER_COUNT ||
+        (atomic_load_explicit(&SIGNAL_SLOT(signalId)->readers[b], memory_order_relaxed) &
+         SIGNALROUTER_WRITING) == 0u) {
         return E_NOT_OK;
     }
-    
-    /* Write value and mark as updated */
-    signal_db[signalId].value = value;
-    signal_db[signalId].updated = TRUE;
-    
+
+    commit_write(signalId, b);
     return E_OK;
 }
 
-Std_ReturnType SignalRouter_Read(SignalRouter_SignalIdType signalId, uint32* value) {
+Std_ReturnType SignalRouter_Subscribe(SignalRouter_SignalIdType signalId,
+                                      SignalRouter_NotificationType notification) {
+    SignalRouter_SubscriberListType* subscribers;
+
+    if (signalId >= SIGNAL_COUNT || notification == NULL) {
+        return E_NOT_OK;
+    }
+
+    subscribers = &signal_subscribers[signalId];
+    if (subscribers->count >= SIGNALROUTER_SUBSCRIBER_COUNT) {
+        printf("[SignalRouter] ERROR: Signal %u has %u subscribers already\n",
+               signalId, SIGNALROUTER_SUBSCRIBER_COUNT);
+        return E_NOT_OK;
+    }
+    subscribers->notification[subscribers->count++] = notification;
+
+    return E_OK;
+}
+
+Std_ReturnType SignalRouter_WriteData(SignalRouter_SignalIdType signalId, const void* data) {
     /* Validate inputs */
     if (signalId >= SIGNAL_COUNT) {
         printf("[SignalRouter] ERROR: Invalid signal ID %u\n", signalId);
         return E_NOT_OK;
     }
-    
-    if (value == NULL) {
+
+    if (data == NULL) {
         printf("[SignalRouter] ERROR: NULL pointer provided\n");
         return E_NOT_OK;
     }
-    
-    /* Read value and clear update flag */
-    *value = signal_db[signalId].value;
-    signal_db[signalId].updated = FALSE;
-    
+
+    return write_value(signalId, data);
+}
+
+Std_ReturnType SignalRouter_Write(SignalRouter_SignalIdType signalId, uint32 value) {
+    if (signalId < SIGNAL_COUNT && signal_config[signalId].size != sizeof(uint32)) {
+        printf("[SignalRouter] ERROR: Signal %u is not a uint32\n", signalId);
+        return E_NOT_OK;
+    }
+
+    return SignalRouter_WriteData(signalId, &value);
+}
+
+Std_ReturnType SignalRouter_ReadDataVersion(SignalRouter_SignalIdType signalId, void* data,
+                                            SignalRouter_VersionType* version) {
+    /* Validate inputs */
+    if (signalId >= SIGNAL_COUNT) {
+        printf("[SignalRouter] ERROR: Invalid signal ID %u\n", signalId);
+        return E_NOT_OK;
+    }
+
+    if (data == NULL || version == NULL) {
+        printf("[SignalRouter] ERROR: NULL pointer provided\n");
+        return E_NOT_OK;
+    }
+
+    *version = read_value(signalId, data);
+
+    return E_OK;
+}
+
+Std_ReturnType SignalRouter_ReadData(SignalRouter_SignalIdType signalId, void* data) {
+    SignalRouter_VersionType version;
+
+    return SignalRouter_ReadDataVersion(signalId, data, &version);
+}
+
+Std_ReturnType SignalRouter_ReadVersion(SignalRouter_SignalIdType signalId, uint32* value,
+                                        SignalRouter_VersionType* version) {
+    if (signalId < SIGNAL_COUNT && signal_config[signalId].size != sizeof(uint32)) {
+        printf("[SignalRouter] ERROR: Signal %u is not a uint32\n", signalId);
+        return E_NOT_OK;
+    }
+
+    return SignalRouter_ReadDataVersion(signalId, value, version);
+}
+
+Std_ReturnType SignalRouter_Read(SignalRouter_SignalIdType signalId, uint32* value) {
+    SignalRouter_VersionType version;
+
+    return SignalRouter_ReadVersion(signalId, value, &version);
+}
+
+const void* SignalRouter_ReadAcquire(SignalRouter_SignalIdType signalId, SignalRouter_VersionType* version) {
+    SignalRouter_SignalSlotType* slot;
+
+    if (signalId >= SIGNAL_COUNT) {
+        printf("[SignalRouter] ERROR: Invalid signal ID %u\n", signalId);
+        return NULL;
+    }
+    if (SIGNAL_PACKED(signalId)) {
+        printf("[SignalRouter] ERROR: Signal %u is a uint32 without buffers\n", signalId);
+        return NULL;
+    }
+
+    /* Pin the latest buffer; back off if a writer claimed it or it stopped being the latest */
+    slot = SIGNAL_SLOT(signalId);
+    for (;;) {
+        uint64 state = atomic_load_explicit(&slot->state, memory_order_acquire);
+        uint32 latest = STATE_BUFFER(state);
+        uint32 readers = atomic_fetch_add_explicit(&slot->readers[latest], 1u, memory_order_acquire);
+
+        if ((readers & SIGNALROUTER_WRITING) == 0u &&
+            STATE_BUFFER(atomic_load_explicit(&slot->state, memory_order_acquire)) == latest) {
+            if (version != NULL) {
+                *version = STATE_VERSION(state);
+            }
+            return SLOT_BUFFER(slot, latest);
+        }
+        atomic_fetch_sub_explicit(&slot->readers[latest], 1u, memory_order_relaxed);
+
+        /* The writer that claimed it releases it at once, unless its process died */
+        if ((readers & SIGNALROUTER_WRITING) != 0u) {
+            recover_buffer(slot, latest);
+        }
+    }
+}
+
+Std_ReturnType SignalRouter_ReadRelease(SignalRouter_SignalIdType signalId, const void* data) {
+    SignalRouter_SignalSlotType* slot;
+    uint32 buffer;
+
+    if (signalId >= SIGNAL_COUNT || data == NULL || SIGNAL_PACKED(signalId)) {
+        return E_NOT_OK;
+    }
+
+    slot = SIGNAL_SLOT(signalId);
+    buffer = buffer_index(slot, data);
+    if (buffer >= SIGNALROUTER_BUFFER_COUNT ||
+        (atomic_load_explicit(&slot->readers[buffer], memory_order_relaxed) & ~SIGNALROUTER_WRITING) == 0u) {
+        return E_NOT_OK;
+    }
+    atomic_fetch_sub_explicit(&slot->readers[buffer], 1u, memory_order_release);
+
     return E_OK;
 }
 
-boolean SignalRouter_IsUpdated(SignalRouter_SignalIdType signalId) {
+boolean SignalRouter_IsUpdated(SignalRouter_SignalIdType signalId, SignalRouter_VersionType version) {
     /* Validate signal ID */
     if (signalId >= SIGNAL_COUNT) {
         return FALSE;
     }
-    
-    return signal_db[signalId].updated;
+
+    if (SIGNAL_PACKED(signalId)) {
+        return (atomic_load_explicit(&database->version[signalId], memory_order_relaxed) != version) ? TRUE : FALSE;
+    }
+    return (STATE_VERSION(atomic_load_explicit(&SIGNAL_SLOT(signalId)->state, memory_order_relaxed)) != version) ?
+           TRUE : FALSE;
+}
+
+Std_ReturnType SignalRouter_CreateSet(const SignalRouter_SignalIdType* signalIds, uint32 count,
+                                      SignalRouter_SignalSetType* set) {
+    uint32 offset = 0;
+
+    if (signalIds == NULL || set == NULL || count > SIGNALROUTER_SET_SIZE) {
+        return E_NOT_OK;
+    }
+
+    /* Validate once; reading and writing the set checks nothing */
+    for (uint32 i = 0; i < count; i++) {
+        if (signalIds[i] >= SIGNAL_COUNT) {
+            printf("[SignalRouter] ERROR: Invalid signal ID %u in set\n", signalIds[i]);
+            return E_NOT_OK;
+        }
+        offset = align_up(offset, signal_config[signalIds[i]].alignment);
+        set->signal[i] = signalIds[i];
+        set->offset[i] = offset;
+        set->size[i] = signal_config[signalIds[i]].size;
+        offset += set->size[i];
+    }
+    set->count = count;
+    set->bytes = offset;
+
+    return E_OK;
+}
+
+void SignalRouter_ReadSet(const SignalRouter_SignalSetType* set, void* values) {
+    uint8* out = values;
+
+    for (uint32 i = 0; i < set->count; i++) {
+        (void)read_value(set->signal[i], &out[set->offset[i]]);
+    }
+}
+
+Std_ReturnType SignalRouter_WriteSet(const SignalRouter_SignalSetType* set, const void* values) {
+    const uint8* in = values;
+    Std_ReturnType result = E_OK;
+
+    for (uint32 i = 0; i < set->count; i++) {
+        if (write_value(set->signal[i], &in[set->offset[i]]) != E_OK) {
+            result = E_NOT_OK;
+        }
+    }
+
+    return result;
+}
+
+Std_ReturnType SignalRouter_ReadMany(const SignalRouter_SignalIdType* signalIds, uint32 count,
+                                     void* values) {
+    SignalRouter_SignalSetType set;
+
+    if (values == NULL || SignalRouter_CreateSet(signalIds, count, &set) != E_OK) {
+        return E_NOT_OK;
+    }
+    SignalRouter_ReadSet(&set, values);
+
+    return E_OK;
+}
+
+Std_ReturnType SignalRouter_WriteMany(const SignalRouter_SignalIdType* signalIds, uint32 count,
+                                      const void* values) {
+    SignalRouter_SignalSetType set;
+
+    if (values == NULL || SignalRouter_CreateSet(signalIds, count, &set) != E_OK) {
+        return E_NOT_OK;
+    }
+
+    return SignalRouter_WriteSet(&set, values);
+}
+
+Std_ReturnType SignalRouter_OpenTracker(SignalRouter_TrackerType* tracker) {
+    if (tracker == NULL || tracker_count >= SIGNALROUTER_TRACKER_COUNT) {
+        return E_NOT_OK;
+    }
+
+    for (uint32 w = 0; w < SIGNALROUTER_BITMAP_WORDS; w++) {
+        atomic_store(&tracker_bitmap[tracker_count].dirty[w], 0u);
+    }
+    *tracker = tracker_count++;
+
+    return E_OK;
+}
+
+Std_ReturnType SignalRouter_CollectChanged(SignalRouter_TrackerType tracker,
+                                           SignalRouter_ChangeSetType* changes) {
+    if (tracker >= tracker_count || changes == NULL) {
+        return E_NOT_OK;
+    }
+
+    /* Only words with a change need the read-modify-write */
+    for (uint32 w = 0; w < SIGNALROUTER_BITMAP_WORDS; w++) {
+        _Atomic uint64* word = &tracker_bitmap[tracker].dirty[w];
+
+        changes->changed[w] = (atomic_load_explicit(word, memory_order_relaxed) != 0u) ?
+                              atomic_exchange_explicit(word, 0u, memory_order_acquire) : 0u;
+    }
+    atomic_thread_fence(memory_order_seq_cst);
+    changes->word = 0;
+
+    return E_OK;
 }
@@ -32,48 +32,351 @@
 
 #include "Std_Types.h"
 
-/* Signal IDs for internal routing */
+/* Signal IDs for internal routing; uint32 signals first, see RTE_IMPLICIT_SIGNAL_COUNT */
 typedef enum {
     SIGNAL_INPUT_A = 0,
     SIGNAL_INPUT_B,
     SIGNAL_OUTPUT_RESULT,
     SIGNAL_STATUS,
+    SIGNAL_KATA_RESULT,             /* Rte_KataResultType */
     SIGNAL_COUNT
 } SignalRouter_SignalIdType;
 
-/* Signal data buffer structure */
+/* Version of a signal's value, grows with every write; 0 = never written.
+ * Each receiver keeps the version it last read, see SignalRouter_IsUpdated() */
+typedef uint32 SignalRouter_VersionType;
+
+/* Called after every committed write of a signal, on the writer's thread */
+typedef void (*SignalRouter_NotificationType)(SignalRouter_SignalIdType signalId);
+
+/* Subscribers per signal */
+#ifndef SIGNALROUTER_SUBSCRIBER_COUNT
+#define SIGNALROUTER_SUBSCRIBER_COUNT 4u
+#endif
+
+/* Signals per signal set */
+#ifndef SIGNALROUTER_SET_SIZE
+#define SIGNALROUTER_SET_SIZE 32u
+#endif
+
+/* Precompiled group of signals moved together, see SignalRouter_CreateSet().
+ * The values of a set are packed in one buffer, each at its natural
+ * alignment in set order - a set of uint32 signals uses a plain uint32 array */
 typedef struct {
-    uint32 value;
-    boolean updated;
-} SignalRouter_SignalDataType;
+    uint32 count;
+    uint32 bytes;                                       /* Size of the packed values */
+    SignalRouter_SignalIdType signal[SIGNALROUTER_SET_SIZE];
+    uint32 offset[SIGNALROUTER_SET_SIZE];               /* Of each value in the packed values */
+    uint32 size[SIGNALROUTER_SET_SIZE];
+} SignalRouter_SignalSetType;
+
+/* Change trackers, see SignalRouter_OpenTracker() */
+#ifndef SIGNALROUTER_TRACKER_COUNT
+#define SIGNALROUTER_TRACKER_COUNT 4u
+#endif
+
+/* 64-bit words of a bitmap with one bit per signal */
+#define SIGNALROUTER_BITMAP_WORDS ((SIGNAL_COUNT + 63u) / 64u)
+
+/* Handle of a change tracker */
+typedef uint32 SignalRouter_TrackerType;
+
+/* Signals changed since the previous collection; bit n of word n / 64 = signal n */
+typedef struct {
+    uint64 changed[SIGNALROUTER_BITMAP_WORDS];
+    uint32 word;                    /* Iteration cursor of SignalRouter_NextChanged() */
+} SignalRouter_ChangeSetType;
+
+/* Buffers per signal larger than a uint32: the latest value plus one per
+ * write in progress and per zero-copy read held at the same time (N readers
+ * + 2 for one writer). With fewer, a write fails when it finds no free
+ * buffer. uint32 signals have none, their values are packed in one array */
+#ifndef SIGNALROUTER_BUFFER_COUNT
+#define SIGNALROUTER_BUFFER_COUNT 3u
+#endif
+
+/* Bytes of the buffer pool shared by the signals larger than a uint32
+ * (SIGNALROUTER_BUFFER_COUNT buffers each) */
+#ifndef SIGNALROUTER_POOL_SIZE
+#define SIGNALROUTER_POOL_SIZE 4096u
+#endif
 
 /**
  * @brief Initialize the Signal Router
- * @return E_OK if successful
+ * @details Lays out the buffers of every signal larger than a uint32, sized
+ * and aligned for its data type, in the buffer pool.
+ * @return E_OK if successful, E_NOT_OK if the signals do not fit in SIGNALROUTER_POOL_SIZE
  */
 Std_ReturnType SignalRouter_Init(void);
 
 /**
- * @brief Write a signal value to internal buffer
+ * @brief Initialize the Signal Router on a database in POSIX shared memory
+ * @details Several ECU processes on one host exchange their signals through
+ * the named segment (shm_open() + mmap()); reads and writes are plain
+ * memory accesses, no system calls. The first process creates the segment
+ * and sets all signals to zero, the others attach and check its layout
+ * header (version, size, signal sizes). Subscribers and change trackers
+ * only see the writes of their own process. Buffers claimed by a writer
+ * process that died are released by the next writer or zero-copy reader
+ * that finds them held; zero-copy reads a dead process still held are not,
+ * so writes of that signal may fail until the segment is recreated.
+ * @param name Segment name, e.g. "/autosar_lab"
+ * @return E_OK if successful, E_NOT_OK if the segment cannot be created or
+ * mapped, or was built for other signals
+ */
+Std_ReturnType SignalRouter_InitShared(const char* name);
+
+/**
+ * @brief Detach from a shared database
+ * @details The segment and its values remain for the other processes; the
+ * router falls back to its private database. No-op without one.
+ */
+void SignalRouter_Deinit(void);
+
+/**
+ * @brief Remove a shared database segment
+ * @details Processes still attached keep using it; the next
+ * SignalRouter_InitShared() creates a fresh one.
+ * @param name Segment name
+ * @return E_OK if successful, E_NOT_OK if it does not exist
+ */
+Std_ReturnType SignalRouter_RemoveShared(const char* name);
+
+/**
+ * @brief Get the size of a signal's data type
+ * @param signalId Signal identifier
+ * @return Size in bytes, 0 if signal ID invalid
+ */
+uint32 SignalRouter_GetSize(SignalRouter_SignalIdType signalId);
+
+/**
+ * @brief Write a signal of any type to internal buffer
+ * @details Copies SignalRouter_GetSize() bytes. Lock-free; safe from any core.
+ * Concurrent writers of the same signal never wait for each other - each
+ * fills a buffer of its own and the last one committed wins. A uint32
+ * signal is one atomic store plus a version increment, on cache lines it
+ * shares with 15 other uint32 signals; larger signals never share one.
+ * Never waits: when readers and other writers hold every spare buffer the
+ * write fails, see SIGNALROUTER_BUFFER_COUNT.
+ * @param signalId Signal identifier
+ * @param data Value to write
+ * @return E_OK if successful, E_NOT_OK if signal ID invalid, pointer NULL or
+ * no buffer free (the value is not written)
+ */
+Std_ReturnType SignalRouter_WriteData(SignalRouter_SignalIdType signalId, const void* data);
+
+/**
+ * @brief Read a signal of any type from internal buffer
+ * @details Copies SignalRouter_GetSize() bytes. Lock-free and wait-free
+ * unless a write of the same signal is published during the copy, which
+ * makes the reader retry. Readers on several cores do not slow each other
+ * down.
+ * @param signalId Signal identifier
+ * @param data Buffer of SignalRouter_GetSize() bytes to store the value
+ * @return E_OK if successful, E_NOT_OK if signal ID invalid or pointer NULL
+ */
+Std_ReturnType SignalRouter_ReadData(SignalRouter_SignalIdType signalId, void* data);
+
+/**
+ * @brief Read a signal of any type together with its version
+ * @param signalId Signal identifier
+ * @param data Buffer of SignalRouter_GetSize() bytes to store the value
+ * @param version Pointer to store the version of the value
+ * @return E_OK if successful, E_NOT_OK if signal ID invalid or pointer NULL
+ */
+Std_ReturnType SignalRouter_ReadDataVersion(SignalRouter_SignalIdType signalId, void* data,
+                                            SignalRouter_VersionType* version);
+
+/**
+ * @brief Start a zero-copy write
+ * @details Returns a buffer no reader or other writer uses, to be filled in
+ * place and published with SignalRouter_WriteCommit(). Other writers of the
+ * signal carry on in other buffers meanwhile. The buffer holds an older
+ * value, not the latest one. Never waits, like SignalRouter_WriteData().
+ * @param signalId Signal identifier, of a signal larger than a uint32
+ * @return Buffer of SignalRouter_GetSize() bytes, NULL if signal ID invalid,
+ * a uint32 or no buffer free
+ */
+void* SignalRouter_WriteBegin(SignalRouter_SignalIdType signalId);
+
+/**
+ * @brief Publish the buffer of SignalRouter_WriteBegin() as the signal's value
+ * @param signalId Signal identifier
+ * @param data Buffer returned by SignalRouter_WriteBegin()
+ * @return E_OK if successful, E_NOT_OK if signal ID invalid or buffer not being written
+ */
+Std_ReturnType SignalRouter_WriteCommit(SignalRouter_SignalIdType signalId, void* data);
+
+/**
+ * @brief Start a zero-copy read
+ * @details Returns the buffer of the latest value, which stays unchanged
+ * until SignalRouter_ReadRelease(); writers use the other buffers meanwhile.
+ * Hold it briefly: writes of the signal fail while readers and writes in
+ * progress hold every buffer but the latest, see SIGNALROUTER_BUFFER_COUNT.
+ * @param signalId Signal identifier, of a signal larger than a uint32
+ * @param version Pointer to store the version of the value, may be NULL
+ * @return Buffer of SignalRouter_GetSize() bytes, NULL if signal ID invalid or a uint32
+ */
+const void* SignalRouter_ReadAcquire(SignalRouter_SignalIdType signalId, SignalRouter_VersionType* version);
+
+/**
+ * @brief End a zero-copy read
+ * @param signalId Signal identifier
+ * @param data Buffer returned by SignalRouter_ReadAcquire()
+ * @return E_OK if successful, E_NOT_OK if signal ID invalid or buffer not acquired
+ */
+Std_ReturnType SignalRouter_ReadRelease(SignalRouter_SignalIdType signalId, const void* data);
+
+/**
+ * @brief Write a uint32 signal value to internal buffer
+ * @details Same as SignalRouter_WriteData() for a uint32.
  * @param signalId Signal identifier
  * @param value Value to write
- * @return E_OK if successful, E_NOT_OK if signal ID invalid
+ * @return E_OK if successful, E_NOT_OK if signal ID invalid or not a uint32
  */
 Std_ReturnType SignalRouter_Write(SignalRouter_SignalIdType signalId, uint32 value);
 
 /**
- * @brief Read a signal value from internal buffer
+ * @brief Read a uint32 signal value from internal buffer
  * @param signalId Signal identifier
  * @param value Pointer to store read value
- * @return E_OK if successful, E_NOT_OK if signal ID invalid or pointer NULL
+ * @return E_OK if successful, E_NOT_OK if signal ID invalid, not a uint32 or pointer NULL
  */
 Std_ReturnType SignalRouter_Read(SignalRouter_SignalIdType signalId, uint32* value);
 
 /**
- * @brief Check if a signal has been updated since last read
+ * @brief Read a uint32 signal value together with its version
+ * @param signalId Signal identifier
+ * @param value Pointer to store read value
+ * @param version Pointer to store the version of the value
+ * @return E_OK if successful, E_NOT_OK if signal ID invalid, not a uint32 or pointer NULL
+ */
+Std_ReturnType SignalRouter_ReadVersion(SignalRouter_SignalIdType signalId, uint32* value,
+                                        SignalRouter_VersionType* version);
+
+/**
+ * @brief Check if a signal has been written since one receiver last read it
+ * @details Every receiver passes the version of its own last read, so any
+ * number of receivers detect the same update; one atomic load, no state in
+ * the SignalRouter.
  * @param signalId Signal identifier
+ * @param version Version of the receiver's last read, 0 if none
  * @return TRUE if updated, FALSE otherwise
  */
-boolean SignalRouter_IsUpdated(SignalRouter_SignalIdType signalId);
+boolean SignalRouter_IsUpdated(SignalRouter_SignalIdType signalId, SignalRouter_VersionType version);
+
+/**
+ * @brief Get notified of every write of a signal
+ * @details The notification runs inline, on the thread of the writer, right
+ * after the new value is published; keep it short. Must be called after
+ * SignalRouter_Init() and before the signal's writers start. The RTE builds
+ * task activation and deferred notification on top, see Rte_SubscribeSignal().
+ * @param signalId Signal identifier
+ * @param notification Function to call
+ * @return E_OK if successful, E_NOT_OK if signal ID invalid, notification
+ * NULL or SIGNALROUTER_SUBSCRIBER_COUNT reached
+ */
+Std_ReturnType SignalRouter_Subscribe(SignalRouter_SignalIdType signalId,
+                                      SignalRouter_NotificationType notification);
+
+/**
+ * @brief Precompile a signal set
+ * @details Validates the signals and computes the layout of their packed
+ * values once, so reading and writing the set is one loop over the
+ * signals without checks or lookups.
+ * @param signalIds Signals of the set
+ * @param count Number of signals, up to SIGNALROUTER_SET_SIZE
+ * @param set Set to fill in
+ * @return E_OK if successful, E_NOT_OK if a signal ID is invalid, count too large or pointer NULL
+ */
+Std_ReturnType SignalRouter_CreateSet(const SignalRouter_SignalIdType* signalIds, uint32 count,
+                                      SignalRouter_SignalSetType* set);
+
+/**
+ * @brief Read every signal of a set into its packed values
+ * @details Each value is consistent on its own like SignalRouter_ReadData();
+ * the set as a whole is not a snapshot of one instant.
+ * @param set Set from SignalRouter_CreateSet()
+ * @param values Buffer of set->bytes bytes
+ */
+void SignalRouter_ReadSet(const SignalRouter_SignalSetType* set, void* values);
+
+/**
+ * @brief Write every signal of a set from its packed values
+ * @param set Set from SignalRouter_CreateSet()
+ * @param values Buffer of set->bytes bytes
+ * @details Writes the signals one by one, each like SignalRouter_WriteData().
+ * A signal that cannot be written is skipped; the others are written anyway.
+ * @return E_OK if successful, E_NOT_OK if a signal found no free buffer
+ */
+Std_ReturnType SignalRouter_WriteSet(const SignalRouter_SignalSetType* set, const void* values);
+
+/**
+ * @brief Read several signals at once
+ * @details Same as SignalRouter_ReadSet() on a set created for this call;
+ * precompile the set instead when reading the same signals repeatedly.
+ * @param signalIds Signals to read
+ * @param count Number of signals, up to SIGNALROUTER_SET_SIZE
+ * @param values Buffer for the packed values
+ * @return E_OK if successful, E_NOT_OK if a signal ID is invalid, count too large or pointer NULL
+ */
+Std_ReturnType SignalRouter_ReadMany(const SignalRouter_SignalIdType* signalIds, uint32 count,
+                                     void* values);
+
+/**
+ * @brief Write several signals at once
+ * @param signalIds Signals to write
+ * @param count Number of signals, up to SIGNALROUTER_SET_SIZE
+ * @param values Packed values
+ * @return E_OK if successful, E_NOT_OK if invalid or a signal could not be written
+ */
+Std_ReturnType SignalRouter_WriteMany(const SignalRouter_SignalIdType* signalIds, uint32 count,
+                                      const void* values);
+
+/**
+ * @brief Open a change tracker
+ * @details A tracker records which signals were written since its owner
+ * last collected them - e.g. a logger asking "what changed since the last
+ * cycle". Writers set one bit per signal in each tracker's bitmap, so a
+ * collection costs one load per 64 signals. Must be called before the
+ * writers start; trackers start with no signal changed.
+ * @param tracker Pointer to store the tracker handle
+ * @return E_OK if successful, E_NOT_OK if SIGNALROUTER_TRACKER_COUNT reached or pointer NULL
+ */
+Std_ReturnType SignalRouter_OpenTracker(SignalRouter_TrackerType* tracker);
+
+/**
+ * @brief Take the signals written since the tracker's previous collection
+ * @details Clears them in the tracker. A signal written during the
+ * collection is reported now or next time, never lost.
+ * @param tracker Handle from SignalRouter_OpenTracker()
+ * @param changes Change set to fill in, ready for SignalRouter_NextChanged()
+ * @return E_OK if successful, E_NOT_OK if tracker invalid or pointer NULL
+ */
+Std_ReturnType SignalRouter_CollectChanged(SignalRouter_TrackerType tracker,
+                                           SignalRouter_ChangeSetType* changes);
+
+/**
+ * @brief Get the next changed signal of a change set, lowest ID first
+ * @details Skips 64 unchanged signals per word test; removes the signal
+ * from the set.
+ * @param changes Change set from SignalRouter_CollectChanged()
+ * @param signalId Pointer to store the signal
+ * @return TRUE if a signal was returned, FALSE if none is left
+ */
+static inline boolean SignalRouter_NextChanged(SignalRouter_ChangeSetType* changes,
+                                               SignalRouter_SignalIdType* signalId) {
+    while (changes->word < SIGNALROUTER_BITMAP_WORDS) {
+        uint64 bits = changes->changed[changes->word];
+
+        if (bits != 0u) {
+            changes->changed[changes->word] = bits & (bits - 1u);
+            *signalId = (SignalRouter_SignalIdType)(changes->word * 64u + (uint32)__builtin_ctzll(bits));
+            return TRUE;
+        }
+        changes->word++;
+    }
+    return FALSE;
+}
 
 #endif /* SIGNAL_ROUTER_H */
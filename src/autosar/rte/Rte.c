@@ -12,6 +12,7 @@
 #include "Rte.h"
 #include "Os.h"
 #include "SignalRouter.h"
+#include <stdatomic.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -19,44 +20,212 @@
 typedef struct {
     uint8 componentId;
     uint8 portId;
+    boolean isWrite;     /* Provide port - read and write ports are numbered separately */
     SignalRouter_SignalIdType signalId;
     boolean isInternal;  /* TRUE = internal routing, FALSE = bus communication */
 } Rte_PortMappingType;
 
 /* Port mapping table - defines which component ports map to which signals */
 static const Rte_PortMappingType port_mapping[] = {
-    /* componentId, portId, signalId,         isInternal */
+    /* componentId, portId, isWrite, signalId,         isInternal */
     /* SwcTemplate ports - internal communication */
-    {0, 0, SIGNAL_INPUT_A,      TRUE},   /* InputA */
-    {0, 1, SIGNAL_INPUT_B,      TRUE},   /* InputB */
-    {0, 0, SIGNAL_OUTPUT_RESULT, TRUE},  /* Output */
+    {0, 0, FALSE, SIGNAL_INPUT_A,       TRUE},   /* InputA */
+    {0, 1, FALSE, SIGNAL_INPUT_B,       TRUE},   /* InputB */
+    {0, 0, TRUE,  SIGNAL_OUTPUT_RESULT, TRUE},   /* Output */
+    {0, 2, FALSE, SIGNAL_KATA_RESULT,   TRUE},   /* KataResult */
     
     /* SwcKata001 ports - internal communication */
-    {1, 0, SIGNAL_INPUT_A,      TRUE},   /* Input1 */
-    {1, 1, SIGNAL_INPUT_B,      TRUE},   /* Input2 */
-    {1, 0, SIGNAL_OUTPUT_RESULT, TRUE},  /* Sum */
+    {1, 0, FALSE, SIGNAL_INPUT_A,       TRUE},   /* Input1 */
+    {1, 1, FALSE, SIGNAL_INPUT_B,       TRUE},   /* Input2 */
+    {1, 0, TRUE,  SIGNAL_OUTPUT_RESULT, TRUE},   /* Sum */
+    {1, 1, TRUE,  SIGNAL_KATA_RESULT,   TRUE},   /* Result */
 };
 
 static const uint32 PORT_MAPPING_COUNT = sizeof(port_mapping) / sizeof(port_mapping[0]);
 
-/* Find signal ID for a component port */
+/* Signal version each read port saw last (Rte_IsUpdated), by port mapping entry */
+static SignalRouter_VersionType port_version[sizeof(port_mapping) / sizeof(port_mapping[0])];
+
+/* Implicit access - signals each task reads at start / writes at end */
+typedef struct {
+    TaskType task;
+    SignalRouter_SignalIdType signalId;
+    boolean isWrite;
+} Rte_ImplicitAccessType;
+
+static const Rte_ImplicitAccessType implicit_access[] = {
+    /* task,     signalId,             isWrite */
+    /* SwcKata001 runnables on TASK_10MS */
+    {TASK_10MS, SIGNAL_INPUT_A,       FALSE},   /* Input1 */
+    {TASK_10MS, SIGNAL_INPUT_B,       FALSE},   /* Input2 */
+    {TASK_10MS, SIGNAL_OUTPUT_RESULT, TRUE},    /* Sum */
+};
+
+_Static_assert(RTE_IMPLICIT_SIGNAL_COUNT <= 32u, "Implicit access masks have one bit per signal");
+
+/* Task-local signal copies, accessed directly by Rte_IRead_* / Rte_IWrite_* */
+Rte_TaskBufferType Rte_TaskBuffer[TASK_COUNT];
+
+/* Signals copied in at task start, one bit per signal */
+static uint32 implicit_read_mask[TASK_COUNT];
+
+/* Signal version in each task buffer - unchanged signals are not copied again */
+static SignalRouter_VersionType implicit_version[TASK_COUNT][RTE_IMPLICIT_SIGNAL_COUNT];
+
+/* Reaction to a signal write, see Rte_SubscribeSignal() / Rte_ActivateOnWrite() */
+typedef struct {
+    SignalRouter_SignalIdType signalId;
+    TaskType task;
+    SignalRouter_NotificationType notification;  /* Deferred notification, NULL = activation */
+    EventMaskType event;                         /* Activation: 0 = Os_ActivateTask(), else Os_SetEvent() */
+} Rte_SignalTriggerType;
+
+static Rte_SignalTriggerType signal_triggers[RTE_SIGNAL_TRIGGER_COUNT];
+static uint32 signal_trigger_count = 0;
+
+/* Signals the RTE subscribed to at the SignalRouter, one bit per signal */
+static uint32 subscribed_signals = 0;
+
+/* Deferred notifications of each task, one bit per signal; repeated writes coalesce */
+static _Atomic uint32 notify_pending[TASK_COUNT];
+
+/* Find signal ID and port mapping entry for a component port */
 static Std_ReturnType Rte_FindSignal(uint8 componentId, uint8 portId, 
                                       boolean isWrite, SignalRouter_SignalIdType* signalId,
-                                      boolean* isInternal) {
+                                      boolean* isInternal, uint32* portIndex) {
     for (uint32 i = 0; i < PORT_MAPPING_COUNT; i++) {
         if (port_mapping[i].componentId == componentId && 
-            port_mapping[i].portId == portId) {
+            port_mapping[i].portId == portId &&
+            port_mapping[i].isWrite == isWrite) {
             *signalId = port_mapping[i].signalId;
             *isInternal = port_mapping[i].isInternal;
+            *portIndex = i;
             return E_OK;
         }
     }
     return E_NOT_OK;
 }
 
+/* SignalRouter notification: queue the deferred notifications, then activate */
+static void Rte_SignalWritten(SignalRouter_SignalIdType signalId) {
+    for (uint32 i = 0; i < signal_trigger_count; i++) {
+        const Rte_SignalTriggerType* trigger = &signal_triggers[i];
+        
+        if (trigger->signalId == signalId && trigger->notification != NULL) {
+            atomic_fetch_or_explicit(&notify_pending[trigger->task], 1u << signalId,
+                                     memory_order_release);
+        }
+    }
+    for (uint32 i = 0; i < signal_trigger_count; i++) {
+        const Rte_SignalTriggerType* trigger = &signal_triggers[i];
+        
+        if (trigger->signalId != signalId || trigger->notification != NULL) {
+            continue;
+        }
+        if (trigger->event == 0u) {
+            Os_ActivateTask(trigger->task);
+        } else {
+            Os_SetEvent(trigger->task, trigger->event);
+        }
+    }
+}
+
+/* Add a trigger, subscribing the RTE to the signal on first use */
+static Std_ReturnType Rte_AddTrigger(const Rte_SignalTriggerType* trigger) {
+    if (signal_trigger_count >= RTE_SIGNAL_TRIGGER_COUNT) {
+        printf("[RTE] ERROR: More than %u signal triggers\n", RTE_SIGNAL_TRIGGER_COUNT);
+        return E_NOT_OK;
+    }
+    if ((subscribed_signals & (1u << trigger->signalId)) == 0u) {
+        if (SignalRouter_Subscribe(trigger->signalId, Rte_SignalWritten) != E_OK) {
+            return E_NOT_OK;
+        }
+        subscribed_signals |= 1u << trigger->signalId;
+    }
+    signal_triggers[signal_trigger_count++] = *trigger;
+    return E_OK;
+}
+
+/* Call the deferred notifications queued for a task */
+static void Rte_DispatchNotifications(TaskType task) {
+    uint32 pending = atomic_exchange_explicit(&notify_pending[task], 0u, memory_order_acquire);
+    
+    while (pending != 0u) {
+        SignalRouter_SignalIdType signalId = (SignalRouter_SignalIdType)__builtin_ctz(pending);
+        pending &= pending - 1u;
+        for (uint32 i = 0; i < signal_trigger_count; i++) {
+            if (signal_triggers[i].signalId == signalId && signal_triggers[i].task == task &&
+                signal_triggers[i].notification != NULL) {
+                signal_triggers[i].notification(signalId);
+            }
+        }
+    }
+}
+
+/* Pre-task hook: copy every signal the task reads implicitly, except the
+ * ones still dirty from a failed write - the task keeps its own value */
+static void Rte_ImplicitRead(TaskType task) {
+    uint32 mask = implicit_read_mask[task] & ~Rte_TaskBuffer[task].dirty;
+    
+    while (mask != 0u) {
+        SignalRouter_SignalIdType signalId = (SignalRouter_SignalIdType)__builtin_ctz(mask);
+        mask &= mask - 1u;
+        if (SignalRouter_IsUpdated(signalId, implicit_version[task][signalId])) {
+            SignalRouter_ReadVersion(signalId, &Rte_TaskBuffer[task].values[signalId],
+                                     &implicit_version[task][signalId]);
+        }
+    }
+}
+
+/* Pre-task hook: implicit inputs first, so deferred notifications see them */
+static void Rte_TaskStart(TaskType task) {
+    Rte_ImplicitRead(task);
+    Rte_DispatchNotifications(task);
+}
+
+/* Post-task hook: publish every signal the task wrote implicitly; a signal
+ * that cannot be written stays dirty and is retried when the next activation ends */
+static void Rte_ImplicitWrite(TaskType task) {
+    uint32 dirty = Rte_TaskBuffer[task].dirty;
+    uint32 failed = 0;
+    
+    while (dirty != 0u) {
+        SignalRouter_SignalIdType signalId = (SignalRouter_SignalIdType)__builtin_ctz(dirty);
+        uint32 value = Rte_TaskBuffer[task].values[signalId];
+        dirty &= dirty - 1u;
+        Os_TraceEvent(OS_TRACE_SIGNAL_WRITE, signalId, value);
+        if (SignalRouter_Write(signalId, value) != E_OK) {
+            failed |= 1u << signalId;
+        }
+    }
+    Rte_TaskBuffer[task].dirty = failed;
+}
+
 Std_ReturnType Rte_Init(void) {
     printf("[RTE] Initializing Runtime Environment...\n");
+    
+    memset(Rte_TaskBuffer, 0, sizeof(Rte_TaskBuffer));
+    memset(implicit_read_mask, 0, sizeof(implicit_read_mask));
+    memset(implicit_version, 0, sizeof(implicit_version));
+    memset(port_version, 0, sizeof(port_version));
+    signal_trigger_count = 0;
+    subscribed_signals = 0;
+    for (uint32 t = 0; t < TASK_COUNT; t++) {
+        atomic_store(&notify_pending[t], 0u);
+    }
+    for (uint32 i = 0; i < sizeof(implicit_access) / sizeof(implicit_access[0]); i++) {
+        if (implicit_access[i].signalId >= RTE_IMPLICIT_SIGNAL_COUNT) {
+            printf("[RTE] ERROR: Signal %u is not a uint32, no implicit access\n", implicit_access[i].signalId);
+            return E_NOT_OK;
+        }
+        if (!implicit_access[i].isWrite) {
+            implicit_read_mask[implicit_access[i].task] |= 1u << implicit_access[i].signalId;
+        }
+    }
+    
     printf("[RTE] Port mappings configured: %u\n", PORT_MAPPING_COUNT);
+    printf("[RTE] Implicit accesses configured: %u\n",
+           (uint32)(sizeof(implicit_access) / sizeof(implicit_access[0])));
     printf("[RTE] Internal routing via SignalRouter\n");
     printf("[RTE] External routing via COM module\n");
     return E_OK;
@@ -65,25 +234,29 @@ Std_ReturnType Rte_Init(void) {
 Std_ReturnType Rte_Start(void) {
     printf("[RTE] Starting RTE...\n");
     /* SWC runnables are registered with OS and will be called automatically */
+    
+    /* Implicit access: copy-in before and copy-out after every task activation */
+    Os_SetTaskHooks(Rte_TaskStart, Rte_ImplicitWrite);
     return E_OK;
 }
 
 Std_ReturnType Rte_Read(uint8 componentId, uint8 portId, void* data) {
     SignalRouter_SignalIdType signalId;
     boolean isInternal;
+    uint32 portIndex;
     
     if (data == NULL) {
         return E_NOT_OK;
     }
     
-    if (Rte_FindSignal(componentId, portId, FALSE, &signalId, &isInternal) != E_OK) {
+    if (Rte_FindSignal(componentId, portId, FALSE, &signalId, &isInternal, &portIndex) != E_OK) {
         return E_NOT_OK;
     }
     
     /* Route based on signal type */
     if (isInternal) {
-        /* Internal signal - use SignalRouter */
-        return SignalRouter_Read(signalId, (uint32*)data);
+        /* Internal signal - use SignalRouter, remember what this port has seen */
+        return SignalRouter_ReadDataVersion(signalId, data, &port_version[portIndex]);
     } else {
         /* External signal - use COM module */
         /* In real system: return Com_ReceiveSignal(mapped_com_signal, data); */
@@ -94,22 +267,68 @@ Std_ReturnType Rte_Read(uint8 componentId, uint8 portId, void* data) {
 Std_ReturnType Rte_Write(uint8 componentId, uint8 portId, const void* data) {
     SignalRouter_SignalIdType signalId;
     boolean isInternal;
+    uint32 portIndex;
     
     if (data == NULL) {
         return E_NOT_OK;
     }
     
-    if (Rte_FindSignal(componentId, portId, TRUE, &signalId, &isInternal) != E_OK) {
+    if (Rte_FindSignal(componentId, portId, TRUE, &signalId, &isInternal, &portIndex) != E_OK) {
         return E_NOT_OK;
     }
     
+    /* Trace the first 32 bits, the whole value of scalar signals */
+    uint32 traceValue = 0;
+    uint32 size = SignalRouter_GetSize(signalId);
+    memcpy(&traceValue, data, (size < sizeof(traceValue)) ? size : sizeof(traceValue));
+    Os_TraceEvent(OS_TRACE_SIGNAL_WRITE, signalId, traceValue);
+    
     /* Route based on signal type */
     if (isInternal) {
         /* Internal signal - use SignalRouter */
-        return SignalRouter_Write(signalId, *(const uint32*)data);
+        return SignalRouter_WriteData(signalId, data);
     } else {
         /* External signal - use COM module */
         /* In real system: return Com_SendSignal(mapped_com_signal, data); */
         return E_NOT_OK;  /* Not implemented in this lab */
     }
 }
+
+boolean Rte_IsUpdated(uint8 componentId, uint8 portId) {
+    SignalRouter_SignalIdType signalId;
+    boolean isInternal;
+    uint32 portIndex;
+    
+    if (Rte_FindSignal(componentId, portId, FALSE, &signalId, &isInternal, &portIndex) != E_OK ||
+        !isInternal) {
+        return FALSE;
+    }
+    
+    return SignalRouter_IsUpdated(signalId, port_version[portIndex]);
+}
+
+Std_ReturnType Rte_SubscribeSignal(SignalRouter_SignalIdType signalId,
+                                   SignalRouter_NotificationType notification,
+                                   Rte_NotifyModeType mode, TaskType task) {
+    if (signalId >= SIGNAL_COUNT || notification == NULL) {
+        return E_NOT_OK;
+    }
+    
+    if (mode == RTE_NOTIFY_INLINE) {
+        return SignalRouter_Subscribe(signalId, notification);
+    }
+    if (mode != RTE_NOTIFY_DEFERRED || task >= TASK_COUNT) {
+        return E_NOT_OK;
+    }
+    
+    return Rte_AddTrigger(&(Rte_SignalTriggerType){ signalId, task, notification, 0u });
+}
+
+Std_ReturnType Rte_ActivateOnWrite(SignalRouter_SignalIdType signalId, TaskType task,
+                                   EventMaskType event) {
+    if (signalId >= SIGNAL_COUNT || task >= TASK_COUNT) {
+        return E_NOT_OK;
+    }
+    
+    return Rte_AddTrigger(&(Rte_SignalTriggerType){ signalId, task, NULL, event });
+}
@@ -15,8 +15,32 @@
 
 #include "Std_Types.h"
 #include "Rte_Type.h"
+#include "Os.h"
 #include "SignalRouter.h"
 
+/* Signals implicit access can hold: the uint32 signals, which come first in
+ * SignalRouter_SignalIdType. Larger signals use Rte_Read / Rte_Write */
+#define RTE_IMPLICIT_SIGNAL_COUNT SIGNAL_KATA_RESULT
+
+/* Task-local copies of the signals accessed implicitly (Rte_IRead_* / Rte_IWrite_*) */
+typedef struct {
+    _Alignas(64) uint32 values[RTE_IMPLICIT_SIGNAL_COUNT];  /* Own cache line per task */
+    uint32 dirty;               /* Signals written and not yet published, one bit each */
+} Rte_TaskBufferType;
+
+extern Rte_TaskBufferType Rte_TaskBuffer[TASK_COUNT];
+
+/* Signal triggers of Rte_SubscribeSignal(RTE_NOTIFY_DEFERRED) and Rte_ActivateOnWrite() */
+#ifndef RTE_SIGNAL_TRIGGER_COUNT
+#define RTE_SIGNAL_TRIGGER_COUNT 16u
+#endif
+
+/* Where Rte_SubscribeSignal() calls a notification */
+typedef enum {
+    RTE_NOTIFY_INLINE = 0,      /* On the writer's thread, right after the write */
+    RTE_NOTIFY_DEFERRED         /* In the subscribing task, before its next activation runs */
+} Rte_NotifyModeType;
+
 /**
  * @brief Initialize the RTE
  * @return E_OK if successful
@@ -25,11 +49,42 @@ Std_ReturnType Rte_Init(void);
 
 /**
  * @brief Start the RTE
- * @details Activates all SWC runnables
+ * @details Activates all SWC runnables and installs the task hooks of
+ * implicit communication (must run after Os_Init())
  * @return E_OK if successful
  */
 Std_ReturnType Rte_Start(void);
 
+/* ============================================
+ * Implicit Communication
+ * ============================================
+ * The RTE copies every signal a task reads implicitly into the task's
+ * buffer right before the task runs, and writes back the signals it wrote
+ * right after. All runnables of one activation see the same, consistent
+ * values, and an access inside a runnable is a plain memory access. The
+ * accesses of each task are configured in the implicit access table of
+ * Rte.c; a runnable must only use the accessors of the task it is mapped to.
+ * A signal that cannot be written back is retried after the next
+ * activation; the task keeps its own value meanwhile. Only uint32 signals
+ * can be accessed implicitly.
+ */
+
+/* Compile error for a constant signal ID beyond RTE_IMPLICIT_SIGNAL_COUNT */
+#define RTE_IMPLICIT_CHECK(signal) \
+    ((void)sizeof(char[1 - 2 * ((signal) >= RTE_IMPLICIT_SIGNAL_COUNT)]))
+
+/* Value of a signal as of the start of the task activation */
+#define RTE_IREAD(task, signal) \
+    (RTE_IMPLICIT_CHECK(signal), Rte_TaskBuffer[(task)].values[(signal)])
+
+/* Set a signal, published when the task activation ends */
+#define RTE_IWRITE(task, signal, data) \
+    do { \
+        RTE_IMPLICIT_CHECK(signal); \
+        Rte_TaskBuffer[(task)].values[(signal)] = (data); \
+        Rte_TaskBuffer[(task)].dirty |= 1u << (signal); \
+    } while (0)
+
 /* ============================================
  * Generic RTE Port Communication APIs
  * ============================================ */
@@ -38,7 +93,7 @@ Std_ReturnType Rte_Start(void);
  * @brief Generic Read operation
  * @param componentId Component identifier
  * @param portId Port identifier
- * @param data Pointer to data buffer
+ * @param data Pointer to a buffer of the port's data type
  * @return E_OK if successful
  */
 Std_ReturnType Rte_Read(uint8 componentId, uint8 portId, void* data);
@@ -47,11 +102,58 @@ Std_ReturnType Rte_Read(uint8 componentId, uint8 portId, void* data);
  * @brief Generic Write operation
  * @param componentId Component identifier
  * @param portId Port identifier
- * @param data Pointer to data buffer
+ * @param data Pointer to a value of the port's data type
  * @return E_OK if successful
  */
 Std_ReturnType Rte_Write(uint8 componentId, uint8 portId, const void* data);
 
+/**
+ * @brief Check if a read port has new data since its last Rte_Read
+ * @details Tracked per port: two components reading the same signal each
+ * see every update once.
+ * @param componentId Component identifier
+ * @param portId Read port identifier
+ * @return TRUE if the signal was written since the port last read it
+ */
+boolean Rte_IsUpdated(uint8 componentId, uint8 portId);
+
+/* ============================================
+ * Data Received Events
+ * ============================================
+ * Instead of polling Rte_IsUpdated() every period, a component can have a
+ * function called or a task activated when a signal is written. Register
+ * after Rte_Init() and before Os_Start(), e.g. in the SWC's init function.
+ */
+
+/**
+ * @brief Call a function whenever a signal is written
+ * @details RTE_NOTIFY_INLINE calls it on the writer's thread - short work
+ * only. RTE_NOTIFY_DEFERRED queues it for 'task', which calls it at the
+ * start of its next activation, after the implicit inputs were read;
+ * writes in between coalesce into one call. Deferred notifications do not
+ * activate the task themselves, see Rte_ActivateOnWrite().
+ * @param signalId Signal identifier
+ * @param notification Function to call
+ * @param mode RTE_NOTIFY_INLINE or RTE_NOTIFY_DEFERRED
+ * @param task Task calling deferred notifications (ignored when inline)
+ * @return E_OK if successful, E_NOT_OK if invalid or out of triggers
+ */
+Std_ReturnType Rte_SubscribeSignal(SignalRouter_SignalIdType signalId,
+                                   SignalRouter_NotificationType notification,
+                                   Rte_NotifyModeType mode, TaskType task);
+
+/**
+ * @brief Activate a task, or set events of an extended task, whenever a signal is written
+ * @details With a task registered with period 0 its runnables only run
+ * when their input changed.
+ * @param signalId Signal identifier
+ * @param task Task to activate
+ * @param event 0 = Os_ActivateTask(), else events for Os_SetEvent()
+ * @return E_OK if successful, E_NOT_OK if invalid or out of triggers
+ */
+Std_ReturnType Rte_ActivateOnWrite(SignalRouter_SignalIdType signalId, TaskType task,
+                                   EventMaskType event);
+
 /* ============================================
  * Component-Specific RTE APIs (Macros)
  * These would typically be auto-generated
@@ -67,6 +169,19 @@ Std_ReturnType Rte_Write(uint8 componentId, uint8 portId, const void* data);
 #define Rte_Write_SwcTemplate_Output(data) \
     Rte_Write(0, 0, (const void*)&(data))
 
+#define Rte_Read_SwcTemplate_KataResult(data) \
+    Rte_Read(0, 2, (void*)(data))
+
+/* Template runnables of TASK_100MS get told about new Kata 001 results */
+#define Rte_Subscribe_SwcTemplate_KataResult(notification) \
+    Rte_SubscribeSignal(SIGNAL_KATA_RESULT, (notification), RTE_NOTIFY_DEFERRED, TASK_100MS)
+
+#define Rte_IsUpdated_SwcTemplate_InputA() \
+    Rte_IsUpdated(0, 0)
+
+#define Rte_IsUpdated_SwcTemplate_InputB() \
+    Rte_IsUpdated(0, 1)
+
 /* Example SWC: Kata 001 (Add Two Numbers) */
 #define Rte_Read_SwcKata001_Input1(data) \
     Rte_Read(1, 0, (void*)(data))
@@ -77,4 +192,17 @@ Std_ReturnType Rte_Write(uint8 componentId, uint8 portId, const void* data);
 #define Rte_Write_SwcKata001_Sum(data) \
     Rte_Write(1, 0, (const void*)&(data))
 
+#define Rte_Write_SwcKata001_Result(data) \
+    Rte_Write(1, 1, (const void*)&(data))
+
+/* Kata 001 implicit access - runnables mapped to TASK_10MS */
+#define Rte_IRead_SwcKata001_Input1() \
+    RTE_IREAD(TASK_10MS, SIGNAL_INPUT_A)
+
+#define Rte_IRead_SwcKata001_Input2() \
+    RTE_IREAD(TASK_10MS, SIGNAL_INPUT_B)
+
+#define Rte_IWrite_SwcKata001_Sum(data) \
+    RTE_IWRITE(TASK_10MS, SIGNAL_OUTPUT_RESULT, (data))
+
 #endif /* RTE_H */
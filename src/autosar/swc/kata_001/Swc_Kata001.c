@@ -22,21 +22,24 @@ void Swc_Kata001_Init(void) {
 }
 
 void Swc_Kata001_Runnable_10ms(void) {
-    uint32 input1, input2, sum;
+    uint32 sum;
+    Rte_KataResultType result;
     
-    /* Read inputs via RTE */
-    Rte_Read_SwcKata001_Input1(&input1);
-    Rte_Read_SwcKata001_Input2(&input2);
+    /* KATA SOLUTION: Add two numbers (implicit access - values as of task start) */
+    sum = Rte_IRead_SwcKata001_Input1() + Rte_IRead_SwcKata001_Input2();
     
-    /* KATA SOLUTION: Add two numbers */
-    sum = input1 + input2;
-    
-    /* Write result via RTE */
-    Rte_Write_SwcKata001_Sum(sum);
+    /* Write result via RTE - published when the task ends */
+    Rte_IWrite_SwcKata001_Sum(sum);
     
     /* Update state */
     kata001_state.total_calculations++;
     kata001_state.last_result = sum;
+    
+    /* Publish the whole result record */
+    result.result = sum;
+    result.valid = TRUE;
+    result.timestamp = kata001_state.total_calculations;
+    Rte_Write_SwcKata001_Result(result);
 }
 
 void Swc_Kata001_Runnable_100ms(void) {
@@ -11,9 +11,18 @@
 
 /* Private variables */
 static uint32 execution_counter = 0;
+static uint32 kata_result_updates = 0;
+
+/* Deferred notification: runs in TASK_100MS, not in the writer */
+static void Swc_Template_KataResultChanged(SignalRouter_SignalIdType signalId) {
+    (void)signalId;
+    kata_result_updates++;
+}
 
 void Swc_Template_Init(void) {
     execution_counter = 0;
+    kata_result_updates = 0;
+    Rte_Subscribe_SwcTemplate_KataResult(Swc_Template_KataResultChanged);
     printf("[SWC_Template] Initialized\n");
 }
 
@@ -40,8 +49,18 @@ void Swc_Template_Runnable_10ms(void) {
 }
 
 void Swc_Template_Runnable_100ms(void) {
+    Rte_KataResultType kataResult;
+    
     /* Optional: Print debug information every 100ms */
     if (execution_counter % 10 == 0) {
         printf("[SWC_Template] Heartbeat - executions: %u\n", execution_counter);
+        
+        /* Only read the result when it changed; structured signals are read whole */
+        if (kata_result_updates != 0u &&
+            Rte_Read_SwcTemplate_KataResult(&kataResult) == E_OK && kataResult.valid) {
+            kata_result_updates = 0;
+            printf("[SWC_Template] Kata result: %u (calculation %u)\n",
+                   kataResult.result, kataResult.timestamp);
+        }
     }
 }
@@ -15,29 +15,43 @@
 #include <stdio.h>
 #include <signal.h>
 #include <stdlib.h>
+#include <string.h>
+
+/* Alarm that ends a virtual-time run */
+#define MAIN_STOP_ALARM 0u
 
 /* Global running flag */
 static volatile boolean running = TRUE;
 
 /* Signal handler for graceful shutdown */
 void signal_handler(int signum) {
-    printf("\n[MAIN] Caught signal %d, shutting down...\n", signum);
+    (void)signum;
     running = FALSE;
-    exit(0);
+    Os_ShutdownAllCores();
+}
+
+/* End of a virtual-time run */
+static void Stop_Simulation(AlarmType alarm) {
+    (void)alarm;
+    Os_ShutdownAllCores();
 }
 
 /* Initialize all BSW modules */
-static void BSW_Init(void) {
+static void BSW_Init(boolean virtual_time, const char* shm_name) {
     printf("========================================\n");
     printf("  AUTOSAR LAB - BSW Initialization\n");
     printf("========================================\n");
     
+    if (virtual_time) {
+        Os_SetClockSource(OS_CLOCK_VIRTUAL);
+    }
+    
     if (Os_Init() != OS_STATUS_OK) {
         printf("[ERROR] OS initialization failed!\n");
         exit(1);
     }
     
-    if (SignalRouter_Init() != E_OK) {
+    if ((shm_name != NULL ? SignalRouter_InitShared(shm_name) : SignalRouter_Init()) != E_OK) {
         printf("[ERROR] SignalRouter initialization failed!\n");
         exit(1);
     }
@@ -98,10 +112,13 @@ static void Register_SWC_Runnables(void) {
     Os_RegisterTask(TASK_10MS, Swc_Template_Runnable_10ms, 10, "SWC_Template_10ms");
     Os_RegisterTask(TASK_100MS, Swc_Template_Runnable_100ms, 100, "SWC_Template_100ms");
     
-    /* Register Kata001 SWC runnables */
-    // Uncomment when you want to run Kata001 instead of template
-    // Os_RegisterTask(TASK_10MS, Swc_Kata001_Runnable_10ms, 10, "SWC_Kata001_10ms");
-    // Os_RegisterTask(TASK_100MS, Swc_Kata001_Runnable_100ms, 100, "SWC_Kata001_100ms");
+    /* Register Kata001 SWC runnables (appended to the same tasks) */
+    Os_RegisterTask(TASK_10MS, Swc_Kata001_Runnable_10ms, 10, "SWC_Kata001_10ms");
+    Os_RegisterTask(TASK_100MS, Swc_Kata001_Runnable_100ms, 100, "SWC_Kata001_100ms");
+    
+    /* SWC tasks run on their own core, BSW stays on the master core */
+    Os_SetTaskApplication(TASK_10MS, OS_APP_SWC);
+    Os_SetTaskApplication(TASK_100MS, OS_APP_SWC);
     
     /* Register COM main functions */
     Os_RegisterTask(TASK_1MS, Com_MainFunctionTx, 5, "COM_MainFunctionTx");
@@ -125,7 +142,27 @@ static void Set_Test_Inputs(void) {
     printf("\n");
 }
 
-int main(void) {
+int main(int argc, char* argv[]) {
+    /* Optional: --virtual <seconds> simulates that long as fast as possible,
+     * --trace <file> records the run and writes it as a Chrome trace,
+     * --shm <name> shares the internal signals with other processes */
+    uint32 virtual_seconds = 0;
+    const char* trace_path = NULL;
+    const char* shm_name = NULL;
+    
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 < argc && strcmp(argv[i], "--virtual") == 0) {
+            virtual_seconds = (uint32)strtoul(argv[i + 1], NULL, 10);
+        } else if (i + 1 < argc && strcmp(argv[i], "--trace") == 0) {
+            trace_path = argv[i + 1];
+        } else if (i + 1 < argc && strcmp(argv[i], "--shm") == 0) {
+            shm_name = argv[i + 1];
+        } else {
+            printf("Usage: %s [--virtual <seconds>] [--trace <file>] [--shm <name>]\n", argv[0]);
+            return 1;
+        }
+    }
+    
     /* Setup signal handler for Ctrl+C */
     signal(SIGINT, signal_handler);
     
@@ -137,7 +174,7 @@ int main(void) {
     printf("\n");
     
     /* System initialization sequence */
-    BSW_Init();
+    BSW_Init(virtual_seconds > 0u, shm_name);
     RTE_Init_And_Start();
     SWC_Init();
     Register_SWC_Runnables();
@@ -146,12 +183,35 @@ int main(void) {
     printf("========================================\n");
     printf("  AUTOSAR LAB - Starting System\n");
     printf("========================================\n");
-    printf("[MAIN] Press Ctrl+C to stop\n");
+    if (virtual_seconds > 0u) {
+        Os_AlarmConfigType stop = {
+            .counter = OS_COUNTER_SYSTEM,
+            .action = OS_ALARM_ACTION_CALLBACK,
+            .callback = Stop_Simulation,
+        };
+        Os_ConfigureAlarm(MAIN_STOP_ALARM, &stop);
+        Os_SetRelAlarm(MAIN_STOP_ALARM, virtual_seconds * 1000u, 0);
+        printf("[MAIN] Simulating %u s in virtual time\n", virtual_seconds);
+    } else {
+        printf("[MAIN] Press Ctrl+C to stop\n");
+    }
     printf("\n");
     
-    /* Start the OS scheduler - this never returns */
+    if (trace_path != NULL) {
+        Os_StartTrace();
+    }
+    
+    /* Start the OS scheduler - returns after Os_ShutdownAllCores() */
     Os_Start();
     
-    /* Should never reach here */
+    if (trace_path != NULL) {
+        Os_StopTrace();
+        if (Os_DumpTrace(trace_path) != OS_STATUS_OK) {
+            printf("[ERROR] Cannot write trace to %s\n", trace_path);
+        }
+    }
+    
+    SignalRouter_Deinit();
+    printf("[MAIN] Shutdown complete (running = %d)\n", running);
     return 0;
 }
@@ -9,6 +9,7 @@
  *   gcc -I../../src/autosar/swc/kata_001 \
  *       -I../../src/autosar/rte \
  *       -I../../src/autosar/bsw/os \
+ *       -I../../src/autosar/bsw/signalrouter \
  *       test_kata001.c \
  *       ../../src/autosar/swc/kata_001/Swc_Kata001.c \
  *       -o test_kata001
@@ -19,49 +20,28 @@
 #include <assert.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include "Rte.h"
 
-/* Mock RTE for testing */
-typedef uint32_t uint32;
-typedef int32_t sint32;
-typedef bool boolean;
-typedef uint8_t Std_ReturnType;
+/* Mock RTE: the implicit buffers are plain data - the test plays the task
+ * hooks and fills the inputs / collects the output itself */
+Rte_TaskBufferType Rte_TaskBuffer[TASK_COUNT];
 
-#define E_OK 0
-#define E_NOT_OK 1
-#define TRUE true
-#define FALSE false
+#define test_input1 (Rte_TaskBuffer[TASK_10MS].values[SIGNAL_INPUT_A])
+#define test_input2 (Rte_TaskBuffer[TASK_10MS].values[SIGNAL_INPUT_B])
+#define test_output (Rte_TaskBuffer[TASK_10MS].values[SIGNAL_OUTPUT_RESULT])
+#define test_output_written ((Rte_TaskBuffer[TASK_10MS].dirty & (1u << SIGNAL_OUTPUT_RESULT)) != 0u)
 
-/* Test data storage */
-static uint32 test_input1 = 0;
-static uint32 test_input2 = 0;
-static uint32 test_output = 0;
+/* Mock RTE: explicit writes of the result record land here */
+static Rte_KataResultType test_result;
 
-/* Mock RTE functions */
-Std_ReturnType Rte_Read(uint8_t componentId, uint8_t portId, void* data) {
-    (void)componentId;
-    
-    if (portId == 0) {
-        *(uint32*)data = test_input1;
-    } else if (portId == 1) {
-        *(uint32*)data = test_input2;
+Std_ReturnType Rte_Write(uint8 componentId, uint8 portId, const void* data) {
+    if (componentId != 1 || portId != 1) {
+        return E_NOT_OK;
     }
-    
+    test_result = *(const Rte_KataResultType*)data;
     return E_OK;
 }
 
-Std_ReturnType Rte_Write(uint8_t componentId, uint8_t portId, const void* data) {
-    (void)componentId;
-    (void)portId;
-    
-    test_output = *(const uint32*)data;
-    return E_OK;
-}
-
-/* Include the SWC under test */
-#define Rte_Read_SwcKata001_Input1(data) Rte_Read(1, 0, (void*)(data))
-#define Rte_Read_SwcKata001_Input2(data) Rte_Read(1, 1, (void*)(data))
-#define Rte_Write_SwcKata001_Sum(data) Rte_Write(1, 0, (const void*)&(data))
-
 /* SWC functions */
 void Swc_Kata001_Init(void);
 void Swc_Kata001_Runnable_10ms(void);
@@ -90,12 +70,15 @@ void run_test(const TestCase* tc) {
     test_input1 = tc->input1;
     test_input2 = tc->input2;
     test_output = 0;
+    test_result.valid = FALSE;
+    Rte_TaskBuffer[TASK_10MS].dirty = 0;
     
     /* Execute */
     Swc_Kata001_Runnable_10ms();
     
     /* Assert */
-    if (test_output == tc->expected) {
+    if (test_output_written && test_output == tc->expected &&
+        test_result.valid && test_result.result == tc->expected) {
         printf("✓ PASS: %s (%u + %u = %u)\n", 
                tc->name, tc->input1, tc->input2, test_output);
     } else {
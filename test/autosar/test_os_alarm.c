@@ -0,0 +1,176 @@
+/**
+ * @file test_os_alarm.c
+ * @brief Unit tests for OS counters and alarms (timing wheel)
+ * @details Drives OS_COUNTER_SOFTWARE by hand and checks every expiry
+ *
+ * Location: test/autosar/test_os_alarm.c
+ *
+ * To compile and run:
+ *   make autosar-tests
+ * or:
+ *   gcc -I../../src/autosar/bsw/os \
+ *       test_os_alarm.c \
+ *       ../../src/autosar/bsw/os/Os.c \
+ *       ../../src/autosar/bsw/os/Os_Alarm.c \
+ *       ../../src/autosar/bsw/os/Os_Coroutine.c \
+ *       ../../src/autosar/bsw/os/Os_Ioc.c \
+ *       ../../src/autosar/bsw/os/Os_Job.c \
+ *       ../../src/autosar/bsw/os/Os_ScheduleTable.c \
+ *       ../../src/autosar/bsw/os/Os_Spinlock.c \
+ *       ../../src/autosar/bsw/os/Os_Trace.c \
+ *       -lrt -lpthread -o test_os_alarm
+ *   ./test_os_alarm
+ */
+
+#include "Os.h"
+#include <stdio.h>
+#include <assert.h>
+
+/* Expiry log filled by the alarm callback */
+static uint32 expiry_count[OS_ALARM_COUNT];
+static TickType last_expiry[OS_ALARM_COUNT];
+
+static void on_alarm(AlarmType alarm) {
+    TickType now;
+    Os_GetCounterValue(OS_COUNTER_SOFTWARE, &now);
+    expiry_count[alarm]++;
+    last_expiry[alarm] = now;
+}
+
+/* Alarms 1 and 2 cancel each other from inside their callback */
+static void on_alarm_cancel_other(AlarmType alarm) {
+    on_alarm(alarm);
+    Os_CancelAlarm((alarm == 1) ? 2 : 1);
+}
+
+static void setup(void) {
+    Os_Init();
+
+    for (AlarmType a = 0; a < OS_ALARM_COUNT; a++) {
+        Os_AlarmConfigType config = {
+            .counter = OS_COUNTER_SOFTWARE,
+            .action = OS_ALARM_ACTION_CALLBACK,
+            .callback = on_alarm,
+        };
+        Os_ConfigureAlarm(a, &config);
+        expiry_count[a] = 0;
+        last_expiry[a] = 0;
+    }
+}
+
+static void advance(uint32 ticks) {
+    for (uint32 i = 0; i < ticks; i++) {
+        Os_IncrementCounter(OS_COUNTER_SOFTWARE);
+    }
+}
+
+static void check(boolean condition, const char* name) {
+    if (condition) {
+        printf("✓ PASS: %s\n", name);
+    } else {
+        printf("✗ FAIL: %s\n", name);
+        assert(0 && "Test failed");
+    }
+}
+
+/* Single-shot alarms on every wheel level expire exactly on time */
+static void test_rel_alarm_levels(void) {
+    static const TickType increments[] = {1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 300001};
+    const uint32 count = sizeof(increments) / sizeof(increments[0]);
+    TickType start;
+
+    setup();
+    advance(37);  /* Start off a wheel boundary */
+    Os_GetCounterValue(OS_COUNTER_SOFTWARE, &start);
+
+    for (uint32 i = 0; i < count; i++) {
+        Os_SetRelAlarm(i, increments[i], 0);
+    }
+    advance(300001);
+
+    boolean ok = TRUE;
+    for (uint32 i = 0; i < count; i++) {
+        if (expiry_count[i] != 1 || last_expiry[i] != start + increments[i]) {
+            printf("  alarm %u: increment %u, expired %u time(s), last at +%u\n",
+                   i, increments[i], expiry_count[i], last_expiry[i] - start);
+            ok = FALSE;
+        }
+    }
+    check(ok, "Relative alarms expire exactly once, on time, on every level");
+}
+
+/* Cyclic alarms keep their period */
+static void test_cyclic_alarm(void) {
+    setup();
+    Os_SetRelAlarm(0, 10, 10);
+    Os_SetRelAlarm(1, 5, 100);
+    advance(1000);
+
+    check(expiry_count[0] == 100 && last_expiry[0] == 1000, "Cyclic alarm with cycle 10 fires 100 times");
+    check(expiry_count[1] == 10 && last_expiry[1] == 905, "Cyclic alarm with cycle 100 keeps its phase");
+}
+
+/* Cancelled alarms never expire; GetAlarm reports the time left */
+static void test_cancel_and_get(void) {
+    TickType left = 0;
+
+    setup();
+    Os_SetRelAlarm(0, 5000, 0);
+    advance(1000);
+    check(Os_GetAlarm(0, &left) == OS_STATUS_OK && left == 4000, "GetAlarm returns remaining ticks");
+    check(Os_SetRelAlarm(0, 1, 0) == OS_STATUS_ERROR, "Arming an armed alarm is rejected");
+    check(Os_CancelAlarm(0) == OS_STATUS_OK, "CancelAlarm on an armed alarm succeeds");
+    check(Os_CancelAlarm(0) == OS_STATUS_ERROR, "CancelAlarm on a disarmed alarm fails");
+    advance(5000);
+    check(expiry_count[0] == 0, "Cancelled alarm does not expire");
+}
+
+/* Absolute alarms, including the immediate case */
+static void test_abs_alarm(void) {
+    TickType now;
+
+    setup();
+    advance(10);
+    Os_GetCounterValue(OS_COUNTER_SOFTWARE, &now);
+
+    Os_SetAbsAlarm(0, now, 0);
+    check(expiry_count[0] == 1, "Absolute alarm at the current value expires immediately");
+
+    Os_SetAbsAlarm(1, now + 200, 0);
+    advance(200);
+    check(expiry_count[1] == 1 && last_expiry[1] == now + 200, "Absolute alarm expires at its start value");
+}
+
+/* An alarm action may cancel another alarm due on the same tick */
+static void test_cancel_from_callback(void) {
+    Os_AlarmConfigType config = {
+        .counter = OS_COUNTER_SOFTWARE,
+        .action = OS_ALARM_ACTION_CALLBACK,
+        .callback = on_alarm_cancel_other,
+    };
+
+    setup();
+    Os_ConfigureAlarm(1, &config);
+    Os_ConfigureAlarm(2, &config);
+    Os_SetRelAlarm(1, 100, 0);
+    Os_SetRelAlarm(2, 100, 0);
+    advance(100);
+
+    /* Same-tick order is unspecified: whichever runs first cancels the other */
+    check(expiry_count[1] + expiry_count[2] == 1, "Alarm cancelled by a same-tick callback does not expire");
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("  Unit Tests: OS Counters and Alarms\n");
+    printf("========================================\n\n");
+
+    test_rel_alarm_levels();
+    test_cyclic_alarm();
+    test_cancel_and_get();
+    test_abs_alarm();
+    test_cancel_from_callback();
+
+    printf("\n✓ All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file test_rte_notify.c
+ * @brief Unit tests for RTE data received events
+ * @details Writes signals through the real SignalRouter and checks the
+ * task activations, events and deferred notifications the RTE triggers.
+ * The OS is mocked: the test plays the task hooks the RTE installs.
+ *
+ * Location: test/autosar/test_rte_notify.c
+ *
+ * To compile and run:
+ *   make autosar-tests
+ * or:
+ *   gcc -I../../src/autosar/rte -I../../src/autosar/bsw/os \
+ *       -I../../src/autosar/bsw/signalrouter \
+ *       test_rte_notify.c ../../src/autosar/rte/Rte.c \
+ *       ../../src/autosar/bsw/signalrouter/SignalRouter.c \
+ *       -lrt -lpthread -o test_rte_notify
+ *   ./test_rte_notify
+ */
+
+#include "Rte.h"
+#include <stdio.h>
+#include <assert.h>
+
+/* Mock OS: activations, events and the pre-task hook of the RTE */
+static uint32 activations[TASK_COUNT];
+static EventMaskType events[TASK_COUNT];
+static Os_TaskHookType pre_task_hook;
+
+StatusType Os_ActivateTask(TaskType task) {
+    activations[task]++;
+    return OS_STATUS_OK;
+}
+
+StatusType Os_SetEvent(TaskType task, EventMaskType mask) {
+    events[task] |= mask;
+    return OS_STATUS_OK;
+}
+
+void Os_SetTaskHooks(Os_TaskHookType pre, Os_TaskHookType post) {
+    pre_task_hook = pre;
+    (void)post;
+}
+
+void Os_TraceEvent(Os_TraceEventType event, uint32 id, uint32 value) {
+    (void)event;
+    (void)id;
+    (void)value;
+}
+
+/* Notification log: calls, and the implicit input of TASK_10MS at the last call */
+static uint32 notify_count;
+static uint32 notify_input;
+
+static void on_input(SignalRouter_SignalIdType signalId) {
+    notify_count++;
+    notify_input = RTE_IREAD(TASK_10MS, signalId);
+}
+
+static void setup(void) {
+    SignalRouter_Init();
+    Rte_Init();
+    Rte_Start();
+
+    for (TaskType t = 0; t < TASK_COUNT; t++) {
+        activations[t] = 0;
+        events[t] = 0;
+    }
+    notify_count = 0;
+    notify_input = 0;
+}
+
+static void check(boolean condition, const char* name) {
+    if (condition) {
+        printf("✓ PASS: %s\n", name);
+    } else {
+        printf("✗ FAIL: %s\n", name);
+        assert(0 && "Test failed");
+    }
+}
+
+/* Every write of the signal activates the task, writes of others do not */
+static void test_activate_on_write(void) {
+    setup();
+    check(Rte_ActivateOnWrite(SIGNAL_STATUS, TASK_100MS, 0) == E_OK, "Activation trigger registered");
+    SignalRouter_Write(SIGNAL_STATUS, 1);
+    SignalRouter_Write(SIGNAL_STATUS, 2);
+    SignalRouter_Write(SIGNAL_INPUT_A, 3);
+    check(activations[TASK_100MS] == 2u, "Task activated once per write of its signal");
+    check(events[TASK_100MS] == 0u, "No events set");
+}
+
+/* With an event mask the task gets events instead of an activation */
+static void test_set_event_on_write(void) {
+    setup();
+    check(Rte_ActivateOnWrite(SIGNAL_STATUS, TASK_1MS, 0x4) == E_OK, "Event trigger registered");
+    SignalRouter_Write(SIGNAL_STATUS, 1);
+    check(events[TASK_1MS] == 0x4u, "Events set on write");
+    check(activations[TASK_1MS] == 0u, "Task not activated");
+}
+
+/* A deferred notification runs in its task, after the implicit inputs were read */
+static void test_deferred_after_implicit_read(void) {
+    setup();
+    check(Rte_SubscribeSignal(SIGNAL_INPUT_A, on_input, RTE_NOTIFY_DEFERRED, TASK_10MS) == E_OK,
+          "Deferred notification registered");
+    SignalRouter_Write(SIGNAL_INPUT_A, 7);
+    check(notify_count == 0u, "Not called on the writer's thread");
+    check(activations[TASK_10MS] == 0u, "Does not activate the task itself");
+
+    pre_task_hook(TASK_10MS);
+    check(notify_count == 1u, "Called at the start of the task");
+    check(notify_input == 7u, "Sees the implicit input of the write");
+
+    pre_task_hook(TASK_100MS);
+    check(notify_count == 1u, "Not called by other tasks");
+}
+
+/* Writes between two activations coalesce into one call */
+static void test_deferred_coalescing(void) {
+    setup();
+    Rte_SubscribeSignal(SIGNAL_INPUT_A, on_input, RTE_NOTIFY_DEFERRED, TASK_10MS);
+    SignalRouter_Write(SIGNAL_INPUT_A, 1);
+    SignalRouter_Write(SIGNAL_INPUT_A, 2);
+    SignalRouter_Write(SIGNAL_INPUT_A, 3);
+
+    pre_task_hook(TASK_10MS);
+    check(notify_count == 1u, "Three writes, one call");
+    check(notify_input == 3u, "Call sees the last value");
+
+    pre_task_hook(TASK_10MS);
+    check(notify_count == 1u, "No call without a new write");
+}
+
+/* An inline notification runs right in the write */
+static void test_inline(void) {
+    setup();
+    check(Rte_SubscribeSignal(SIGNAL_INPUT_B, on_input, RTE_NOTIFY_INLINE, TASK_10MS) == E_OK,
+          "Inline notification registered");
+    SignalRouter_Write(SIGNAL_INPUT_B, 5);
+    check(notify_count == 1u, "Called on the writer's thread");
+}
+
+/* Triggers beyond RTE_SIGNAL_TRIGGER_COUNT are refused */
+static void test_trigger_limit(void) {
+    boolean registered = TRUE;
+
+    setup();
+    for (uint32 i = 0; i < RTE_SIGNAL_TRIGGER_COUNT; i++) {
+        registered = registered && Rte_ActivateOnWrite(SIGNAL_STATUS, TASK_100MS, 0) == E_OK;
+    }
+    check(registered, "RTE_SIGNAL_TRIGGER_COUNT triggers registered");
+    check(Rte_ActivateOnWrite(SIGNAL_STATUS, TASK_100MS, 0) == E_NOT_OK, "One more is refused");
+    check(Rte_SubscribeSignal(SIGNAL_INPUT_A, on_input, RTE_NOTIFY_DEFERRED, TASK_10MS) == E_NOT_OK,
+          "Deferred notifications share the limit");
+
+    SignalRouter_Write(SIGNAL_STATUS, 1);
+    check(activations[TASK_100MS] == RTE_SIGNAL_TRIGGER_COUNT, "Registered triggers still work");
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("  Unit Tests: RTE Data Received Events\n");
+    printf("========================================\n\n");
+
+    test_activate_on_write();
+    test_set_event_on_write();
+    test_deferred_after_implicit_read();
+    test_deferred_coalescing();
+    test_inline();
+    test_trigger_limit();
+
+    printf("\n✓ All tests passed!\n");
+    return 0;
+}
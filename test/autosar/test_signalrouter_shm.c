@@ -0,0 +1,154 @@
+/**
+ * @file test_signalrouter_shm.c
+ * @brief Unit tests for the SignalRouter database in POSIX shared memory
+ * @details Forks processes that attach to the same segment: values cross
+ * the process boundary, buffers claimed by a writer process that died are
+ * released, and a segment with another layout is refused.
+ *
+ * Location: test/autosar/test_signalrouter_shm.c
+ *
+ * To compile and run:
+ *   make autosar-tests
+ * or:
+ *   gcc -I../../src/autosar/bsw/signalrouter -I../../src/autosar/rte ... \
+ *       test_signalrouter_shm.c ../../src/autosar/bsw/signalrouter/SignalRouter.c \
+ *       -lrt -lpthread -o test_signalrouter_shm
+ *   ./test_signalrouter_shm
+ */
+
+#define _GNU_SOURCE
+
+#include "SignalRouter.h"
+#include "Rte_Type.h"
+#include <stdio.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* 32-bit words of the database layout header, one cache line */
+#define HEADER_WORDS 16u
+
+static char segment[64];
+
+static void check(boolean condition, const char* name) {
+    if (condition) {
+        printf("✓ PASS: %s\n", name);
+    } else {
+        printf("✗ FAIL: %s\n", name);
+        SignalRouter_RemoveShared(segment);
+        assert(0 && "Test failed");
+    }
+}
+
+/* Run child() in a forked process; TRUE if it exited with 0 */
+static boolean run_child(int (*child)(void)) {
+    int status;
+    pid_t pid = fork();
+
+    if (pid == 0) {
+        _exit(child());
+    }
+    return pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/* Attached child: read the parent's value, answer on another signal */
+static int child_echo(void) {
+    uint32 value = 0;
+
+    if (SignalRouter_InitShared(segment) != E_OK || SignalRouter_Read(SIGNAL_INPUT_A, &value) != E_OK) {
+        return 1;
+    }
+    return SignalRouter_Write(SIGNAL_INPUT_B, value + 1u) == E_OK ? 0 : 1;
+}
+
+/* Attached child: claim every spare buffer and die in the middle of the writes */
+static int child_die_writing(void) {
+    if (SignalRouter_InitShared(segment) != E_OK) {
+        return 1;
+    }
+    for (uint32 b = 1; b < SIGNALROUTER_BUFFER_COUNT; b++) {
+        if (SignalRouter_WriteBegin(SIGNAL_KATA_RESULT) == NULL) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void setup(void) {
+    SignalRouter_RemoveShared(segment);
+    SignalRouter_InitShared(segment);
+}
+
+/* A value written by one process is read by another, and back */
+static void test_values_cross_processes(void) {
+    uint32 value = 0;
+
+    setup();
+    SignalRouter_Write(SIGNAL_INPUT_A, 41);
+    check(run_child(child_echo), "Child process attaches and reads the value");
+    SignalRouter_Read(SIGNAL_INPUT_B, &value);
+    check(value == 42u, "Parent reads the child's value");
+}
+
+/* Buffers claimed by a dead writer process are released for the next writer */
+static void test_dead_writer_recovered(void) {
+    Rte_KataResultType record = { 0 };
+    const void* held;
+
+    setup();
+    SignalRouter_WriteData(SIGNAL_KATA_RESULT, &(Rte_KataResultType){ .result = 1 });
+    check(run_child(child_die_writing), "Child process dies holding every spare buffer");
+    check(SignalRouter_WriteData(SIGNAL_KATA_RESULT, &(Rte_KataResultType){ .result = 2 }) == E_OK,
+          "Write after the dead writer succeeds");
+    check(SignalRouter_WriteData(SIGNAL_KATA_RESULT, &(Rte_KataResultType){ .result = 3 }) == E_OK,
+          "Every buffer is usable again");
+    SignalRouter_ReadData(SIGNAL_KATA_RESULT, &record);
+    check(record.result == 3u, "Value of the last write is read");
+    held = SignalRouter_ReadAcquire(SIGNAL_KATA_RESULT, NULL);
+    check(held != NULL && SignalRouter_ReadRelease(SIGNAL_KATA_RESULT, held) == E_OK, "Zero-copy read still works");
+}
+
+/* A segment laid out by another build is refused */
+static void test_layout_mismatch(void) {
+    uint32 header[HEADER_WORDS];
+    int fd;
+
+    SignalRouter_Init();
+    SignalRouter_RemoveShared(segment);
+
+    /* Magic, an unknown version, every other header word nonzero so it reads as ready */
+    for (uint32 i = 0; i < HEADER_WORDS; i++) {
+        header[i] = 1u;
+    }
+    header[0] = 0x53524442u;
+    header[1] = 999u;
+    fd = shm_open(segment, O_RDWR | O_CREAT | O_EXCL, 0600);
+    check(fd >= 0 && ftruncate(fd, 1 << 20) == 0 && write(fd, header, sizeof(header)) == sizeof(header),
+          "Segment with another layout created");
+    close(fd);
+
+    check(SignalRouter_InitShared(segment) == E_NOT_OK, "Attaching to it fails");
+    check(SignalRouter_Write(SIGNAL_INPUT_A, 5) == E_OK, "Router keeps its private database");
+}
+
+int main(void) {
+    /* Forked children must not repeat buffered output */
+    setvbuf(stdout, NULL, _IONBF, 0);
+    snprintf(segment, sizeof(segment), "/test_signalrouter_shm_%d", (int)getpid());
+
+    printf("========================================\n");
+    printf("  Unit Tests: SignalRouter Shared Memory\n");
+    printf("========================================\n\n");
+
+    test_values_cross_processes();
+    test_dead_writer_recovered();
+    test_layout_mismatch();
+
+    SignalRouter_Deinit();
+    SignalRouter_RemoveShared(segment);
+    printf("\n✓ All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,284 @@
+/**
+ * @file bench_signalrouter.c
+ * @brief Benchmark - SignalRouter under concurrent writers and readers
+ * @details One writer thread updates a signal as fast as it can while 1, 2
+ * and 4 reader threads read it, then the same with the readers on another
+ * signal. Every written value is larger than the one before, so a reader
+ * that ever sees a value go back has read a torn or stale update. Reports
+ * the read throughput, which should grow with the number of reader threads
+ * on hosts with enough CPUs, and not drop when the writer works on another
+ * signal.
+ *
+ * Then the same writer fills an Rte_KataResultType in place with
+ * SignalRouter_WriteBegin() / WriteCommit() while the readers hold it with
+ * SignalRouter_ReadAcquire() / ReadRelease(); every record has equal fields,
+ * so a reader that sees them differ has seen a buffer being written. The
+ * record is also written by two writers at once, which must not wait for
+ * each other. The bench is built with a buffer for each of them.
+ *
+ * Finally a single thread reads the four uint32 signals one call each and
+ * as one precompiled signal set, and both must return the same values.
+ * A change tracker opened last must report exactly the signals written
+ * after it was opened, once.
+ *
+ * Location: tools/bench/bench_signalrouter.c
+ *
+ * Build and run:
+ *   make autosar-bench
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "SignalRouter.h"
+#include "Rte_Type.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_MAX_READERS   4u
+#define BENCH_MAX_WRITERS   2u
+#define BENCH_DURATION_NS   200000000u
+#define BENCH_SET_ROUNDS    5000000u
+
+typedef struct {
+    SignalRouter_SignalIdType signal;
+    boolean zeroCopy;
+    boolean monotonic;              /* One writer: values never go back */
+    uint64_t reads;
+    uint32 violations;              /* Values that went back or records torn */
+} ReaderType;
+
+static _Atomic boolean running = FALSE;
+static _Atomic uint32 ready_threads = 0;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void* writer_main(void* arg) {
+    uint64_t* writes = arg;
+    uint32 value = 0;
+
+    atomic_fetch_add(&ready_threads, 1u);
+    while (atomic_load_explicit(&running, memory_order_relaxed)) {
+        SignalRouter_Write(SIGNAL_INPUT_A, ++value);
+    }
+    *writes = value;
+
+    return NULL;
+}
+
+static void* record_writer_main(void* arg) {
+    uint64_t* writes = arg;
+    uint32 value = 0;
+
+    atomic_fetch_add(&ready_threads, 1u);
+    while (atomic_load_explicit(&running, memory_order_relaxed)) {
+        Rte_KataResultType* record = SignalRouter_WriteBegin(SIGNAL_KATA_RESULT);
+
+        if (record == NULL) {
+            continue;   /* No buffer released in time */
+        }
+        value++;
+        record->result = value;
+        record->valid = TRUE;
+        record->timestamp = value;
+        SignalRouter_WriteCommit(SIGNAL_KATA_RESULT, record);
+    }
+    *writes = value;
+
+    return NULL;
+}
+
+static void* reader_main(void* arg) {
+    ReaderType* reader = arg;
+    uint32 last = 0;
+    uint32 value;
+
+    atomic_fetch_add(&ready_threads, 1u);
+    while (atomic_load_explicit(&running, memory_order_relaxed)) {
+        if (reader->zeroCopy) {
+            const Rte_KataResultType* record = SignalRouter_ReadAcquire(reader->signal, NULL);
+
+            if (record->result != record->timestamp) {
+                reader->violations++;
+            }
+            value = record->result;
+            SignalRouter_ReadRelease(reader->signal, record);
+        } else {
+            SignalRouter_Read(reader->signal, &value);
+        }
+        if (reader->monotonic && value < last) {
+            reader->violations++;
+        }
+        last = value;
+        reader->reads++;
+    }
+
+    return NULL;
+}
+
+/* Run 'writer_count' writers and 'reader_count' readers of 'signal'; returns the violations */
+static uint32 run(uint32 writer_count, uint32 reader_count, SignalRouter_SignalIdType signal,
+                  const char* label) {
+    boolean zeroCopy = (signal == SIGNAL_KATA_RESULT);
+    pthread_t writer[BENCH_MAX_WRITERS];
+    pthread_t threads[BENCH_MAX_READERS];
+    ReaderType readers[BENCH_MAX_READERS];
+    uint64_t written[BENCH_MAX_WRITERS] = { 0 };
+    uint64_t writes = 0;
+    uint64_t reads = 0;
+    uint32 violations = 0;
+    uint64_t t0;
+    uint64_t elapsed;
+
+    SignalRouter_Write(SIGNAL_INPUT_A, 0);
+    SignalRouter_WriteData(SIGNAL_KATA_RESULT, &(Rte_KataResultType){ 0 });
+    atomic_store(&ready_threads, 0u);
+    atomic_store(&running, TRUE);
+
+    for (uint32 w = 0; w < writer_count; w++) {
+        pthread_create(&writer[w], NULL, zeroCopy ? record_writer_main : writer_main, &written[w]);
+    }
+    for (uint32 r = 0; r < reader_count; r++) {
+        readers[r] = (ReaderType){ .signal = signal, .zeroCopy = zeroCopy,
+                                   .monotonic = (writer_count == 1u) };
+        pthread_create(&threads[r], NULL, reader_main, &readers[r]);
+    }
+    while (atomic_load(&ready_threads) < reader_count + writer_count) {
+        sched_yield();
+    }
+
+    t0 = now_ns();
+    nanosleep(&(struct timespec){ 0, BENCH_DURATION_NS }, NULL);
+    atomic_store(&running, FALSE);
+    elapsed = now_ns() - t0;
+
+    for (uint32 w = 0; w < writer_count; w++) {
+        pthread_join(writer[w], NULL);
+        writes += written[w];
+    }
+    for (uint32 r = 0; r < reader_count; r++) {
+        pthread_join(threads[r], NULL);
+        reads += readers[r].reads;
+        violations += readers[r].violations;
+    }
+
+    printf("%-18s %u writer(s), %u reader(s): %8.1f M reads/s (%6.1f M per reader), %6.1f M writes/s\n",
+           label, writer_count, reader_count, (double)reads * 1000.0 / (double)elapsed,
+           (double)reads * 1000.0 / (double)elapsed / reader_count,
+           (double)writes * 1000.0 / (double)elapsed);
+    return violations;
+}
+
+/* Read the uint32 signals one by one, then as a set; returns the mismatches */
+static uint32 run_set(void) {
+    static const SignalRouter_SignalIdType ids[] = {
+        SIGNAL_INPUT_A, SIGNAL_INPUT_B, SIGNAL_OUTPUT_RESULT, SIGNAL_STATUS
+    };
+    const uint32 count = sizeof(ids) / sizeof(ids[0]);
+    SignalRouter_SignalSetType set;
+    uint32 single[sizeof(ids) / sizeof(ids[0])];
+    uint32 batch[sizeof(ids) / sizeof(ids[0])];
+    uint32 mismatches = 0;
+    uint64_t t0;
+    uint64_t single_ns;
+    uint64_t batch_ns;
+
+    for (uint32 i = 0; i < count; i++) {
+        SignalRouter_Write(ids[i], 100u + i);
+    }
+    SignalRouter_CreateSet(ids, count, &set);
+
+    t0 = now_ns();
+    for (uint32 n = 0; n < BENCH_SET_ROUNDS; n++) {
+        for (uint32 i = 0; i < count; i++) {
+            SignalRouter_Read(ids[i], &single[i]);
+        }
+        __asm__ volatile("" : : "r"(single) : "memory");
+    }
+    single_ns = now_ns() - t0;
+
+    t0 = now_ns();
+    for (uint32 n = 0; n < BENCH_SET_ROUNDS; n++) {
+        SignalRouter_ReadSet(&set, batch);
+        __asm__ volatile("" : : "r"(batch) : "memory");
+    }
+    batch_ns = now_ns() - t0;
+
+    for (uint32 i = 0; i < count; i++) {
+        mismatches += (single[i] != batch[i] || batch[i] != 100u + i) ? 1u : 0u;
+    }
+    printf("%-18s %u signals: %6.1f ns one by one, %6.1f ns as a set\n", "Batch read:", count,
+           (double)single_ns / BENCH_SET_ROUNDS, (double)batch_ns / BENCH_SET_ROUNDS);
+    return mismatches;
+}
+
+int main(void) {
+    uint32 violations = 0;
+    uint32 value;
+
+    SignalRouter_Init();
+
+    printf("\n");
+    printf("========================================\n");
+    printf("  Benchmark: SignalRouter\n");
+    printf("========================================\n");
+    for (uint32 readers = 1; readers <= BENCH_MAX_READERS; readers *= 2u) {
+        violations += run(1u, readers, SIGNAL_INPUT_A, "Same signal:");
+    }
+    for (uint32 readers = 1; readers <= BENCH_MAX_READERS; readers *= 2u) {
+        violations += run(1u, readers, SIGNAL_INPUT_B, "Other signal:");
+    }
+    for (uint32 readers = 1; readers <= BENCH_MAX_READERS; readers *= 2u) {
+        violations += run(1u, readers, SIGNAL_KATA_RESULT, "Zero-copy record:");
+    }
+    violations += run(BENCH_MAX_WRITERS, 2u, SIGNAL_KATA_RESULT, "Zero-copy record:");
+    violations += run_set();
+
+    /* Each receiver sees the update until it reads it, independent of the others */
+    SignalRouter_VersionType first = 0;
+    SignalRouter_VersionType second = 0;
+    SignalRouter_Write(SIGNAL_STATUS, 1);
+    boolean updated = SignalRouter_IsUpdated(SIGNAL_STATUS, first) &&
+                      SignalRouter_IsUpdated(SIGNAL_STATUS, second);
+    SignalRouter_ReadVersion(SIGNAL_STATUS, &value, &first);
+    boolean independent = !SignalRouter_IsUpdated(SIGNAL_STATUS, first) &&
+                          SignalRouter_IsUpdated(SIGNAL_STATUS, second);
+
+    /* Change tracking: two writes, reported once, in signal order */
+    SignalRouter_TrackerType tracker;
+    SignalRouter_ChangeSetType changes;
+    SignalRouter_SignalIdType changed;
+    uint32 reported = 0;
+    SignalRouter_OpenTracker(&tracker);
+    SignalRouter_Write(SIGNAL_STATUS, 2);
+    SignalRouter_Write(SIGNAL_INPUT_B, 2);
+    SignalRouter_Write(SIGNAL_STATUS, 3);
+    SignalRouter_CollectChanged(tracker, &changes);
+    boolean tracked = SignalRouter_NextChanged(&changes, &changed) && changed == SIGNAL_INPUT_B &&
+                      SignalRouter_NextChanged(&changes, &changed) && changed == SIGNAL_STATUS &&
+                      !SignalRouter_NextChanged(&changes, &changed);
+    SignalRouter_CollectChanged(tracker, &changes);
+    while (SignalRouter_NextChanged(&changes, &changed)) {
+        reported++;
+    }
+
+    if (violations != 0u) {
+        printf("✗ %u reads went back to an older value or saw a torn record or set value\n", violations);
+        return 1;
+    }
+    if (!updated || !independent || value != 1u) {
+        printf("✗ Update detection not tracked per receiver\n");
+        return 1;
+    }
+    if (!tracked || reported != 0u) {
+        printf("✗ Change tracker reported the wrong signals\n");
+        return 1;
+    }
+    return 0;
+}
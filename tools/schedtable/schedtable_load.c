@@ -0,0 +1,172 @@
+/**
+ * @file schedtable_load.c
+ * @brief Tool - per-tick load of a schedule table before and after offsetting
+ * @details Runs the OS twice on the system counter with the same three tasks
+ * (5, 10 and 20 ms), driven by a 20-tick repeating schedule table:
+ *   - before: every task is activated at offset 0 of its period
+ *   - after:  the 10 ms and 20 ms tasks are shifted to free ticks
+ * Each task busy-waits for a fixed cost; the tool records the measured CPU
+ * time per tick of the table and prints both profiles side by side. The OS
+ * runs in virtual time, so the rounds take only the CPU time of the tasks.
+ *
+ * Location: tools/schedtable/schedtable_load.c
+ *
+ * Build and run:
+ *   make autosar-schedtable
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Os.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define TABLE_DURATION  20u     /* Ticks (ms) - the hyperperiod of the task set */
+#define TABLE_ROUNDS    100u    /* Rounds measured per configuration */
+#define TABLE_START     20u     /* Ticks between Os_Init() and the first round */
+
+#define COST_5MS_US     150u
+#define COST_10MS_US    250u
+#define COST_20MS_US    400u
+
+#define SHUTDOWN_ALARM  0u
+
+/* All activations stacked on the period boundaries */
+static const Os_ExpiryPointType points_before[] = {
+    { 0u, TASK_1MS, 0u }, { 0u, TASK_10MS, 0u }, { 0u, TASK_100MS, 0u },
+    { 5u, TASK_1MS, 0u },
+    { 10u, TASK_1MS, 0u }, { 10u, TASK_10MS, 0u },
+    { 15u, TASK_1MS, 0u },
+};
+
+/* Same periods, 10 ms task at offset 2 and 20 ms task at offset 3 */
+static const Os_ExpiryPointType points_after[] = {
+    { 0u, TASK_1MS, 0u },
+    { 2u, TASK_10MS, 0u },
+    { 3u, TASK_100MS, 0u },
+    { 5u, TASK_1MS, 0u },
+    { 10u, TASK_1MS, 0u },
+    { 12u, TASK_10MS, 0u },
+    { 15u, TASK_1MS, 0u },
+};
+
+/* Measured busy time per table tick, summed over all rounds */
+static uint64_t load_ns[TABLE_DURATION];
+static TickType table_start;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Burn 'cost_us' of CPU and book it on the current table tick */
+static void busy_runnable(uint32 cost_us) {
+    TickType tick;
+    uint64_t t0 = now_ns();
+
+    Os_GetCounterValue(OS_COUNTER_SYSTEM, &tick);
+    while (now_ns() - t0 < (uint64_t)cost_us * 1000u) {
+        /* Spin */
+    }
+
+    /* Ignore the activation done by Os_Start() before the table runs */
+    TickType elapsed = tick - table_start;
+    if ((sint32)elapsed >= 0 && elapsed < TABLE_DURATION * TABLE_ROUNDS) {
+        load_ns[elapsed % TABLE_DURATION] += now_ns() - t0;
+    }
+}
+
+static void Task5ms(void) { busy_runnable(COST_5MS_US); }
+static void Task10ms(void) { busy_runnable(COST_10MS_US); }
+static void Task20ms(void) { busy_runnable(COST_20MS_US); }
+
+static void stop_measurement(AlarmType alarm) {
+    (void)alarm;
+    Os_ShutdownAllCores();
+}
+
+/* Run the OS with one schedule table; fills profile[] with µs per tick */
+static void measure(const Os_ExpiryPointType* points, uint32 point_count, uint32* profile) {
+    const Os_ScheduleTableConfigType table = {
+        .counter = OS_COUNTER_SYSTEM,
+        .duration = TABLE_DURATION,
+        .repeating = TRUE,
+        .points = points,
+        .point_count = point_count,
+    };
+    const Os_AlarmConfigType shutdown = {
+        .counter = OS_COUNTER_SYSTEM,
+        .action = OS_ALARM_ACTION_CALLBACK,
+        .callback = stop_measurement,
+    };
+
+    memset(load_ns, 0, sizeof(load_ns));
+
+    Os_SetClockSource(OS_CLOCK_VIRTUAL);
+    Os_Init();
+    Os_RegisterTask(TASK_1MS, Task5ms, 0, "Task5ms");
+    Os_RegisterTask(TASK_10MS, Task10ms, 0, "Task10ms");
+    Os_RegisterTask(TASK_100MS, Task20ms, 0, "Task20ms");
+
+    Os_GetCounterValue(OS_COUNTER_SYSTEM, &table_start);
+    table_start += TABLE_START;
+
+    Os_ConfigureScheduleTable(0, &table);
+    Os_StartScheduleTableAbs(0, table_start);
+    Os_ConfigureAlarm(SHUTDOWN_ALARM, &shutdown);
+    Os_SetAbsAlarm(SHUTDOWN_ALARM, table_start + TABLE_DURATION * TABLE_ROUNDS, 0);
+
+    Os_Start();
+
+    for (uint32 t = 0; t < TABLE_DURATION; t++) {
+        profile[t] = (uint32)(load_ns[t] / TABLE_ROUNDS / 1000u);
+    }
+}
+
+/* Bar of one '#' per 50 µs */
+static void print_bar(uint32 us) {
+    char bar[41];
+    uint32 len = us / 50u;
+
+    if (len > 40u) {
+        len = 40u;
+    }
+    memset(bar, '#', len);
+    bar[len] = '\0';
+    printf("%-20s", bar);
+}
+
+int main(void) {
+    uint32 before[TABLE_DURATION];
+    uint32 after[TABLE_DURATION];
+    uint32 peak_before = 0;
+    uint32 peak_after = 0;
+
+    measure(points_before, sizeof(points_before) / sizeof(points_before[0]), before);
+    measure(points_after, sizeof(points_after) / sizeof(points_after[0]), after);
+
+    printf("\n");
+    printf("========================================\n");
+    printf("  Schedule table load per tick (us, mean of %u rounds)\n", TABLE_ROUNDS);
+    printf("========================================\n");
+    printf("Tick | before (us)                  | after (us)\n");
+    for (uint32 t = 0; t < TABLE_DURATION; t++) {
+        printf("%4u | %5u ", t, before[t]);
+        print_bar(before[t]);
+        printf("   | %5u ", after[t]);
+        print_bar(after[t]);
+        printf("\n");
+
+        if (before[t] > peak_before) {
+            peak_before = before[t];
+        }
+        if (after[t] > peak_after) {
+            peak_after = after[t];
+        }
+    }
+    printf("Peak | %5u                        | %5u\n", peak_before, peak_after);
+
+    return 0;
+}